@@ -0,0 +1,246 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <cmath>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "graph.cpp"
+#include "local_search.cpp"
+
+namespace annealing {
+
+	// parallel tempering (replica exchange) simulated annealing on the machine sequences. every replica is a thread with
+	// its own disjunctive graph that applies random moves of the critical block neighborhood with the metropolis rule
+	// at the temperature of its slot, the temperatures growing geometrically from the first slot to the last. a move is
+	// first screened with the estimate of the local search against the makespan the drawn threshold allows, and only
+	// applied, with the incremental update of the graph, when the estimate is under it. the exact makespan then decides
+	// and a rejected move is undone. every exchange_interval steps a replica tries to swap its slot with a neighboring
+	// one, with the usual exchange probability on the published makespans. swaps are non-blocking: the two slots are
+	// claimed with compare and exchange, and an attempt that finds one of them claimed is simply skipped
+	struct ParallelTempering : util::SearchLimits {
+
+		jssp::Jobs& jobs;
+		int number_of_machines;
+		int lower_bound = 0; // largest job work or machine load, the replicas stop when the best makespan reaches it
+
+		long steps = std::numeric_limits<long>::max(); // steps of every replica
+		int number_of_threads = 0; // one replica per thread, 0 means one per hardware thread
+		// temperatures of the first and last slots as fractions of the initial makespan
+		float min_temperature = 0.0005f;
+		float max_temperature = 0.01f;
+		int exchange_interval = 100;
+		local_search::Neighborhood neighborhood = local_search::Neighborhood::n6;
+		jssp::Schedule initial_schedule;
+
+		std::vector<float> temperatures; // of every slot
+		std::unique_ptr<std::atomic<int>[]> replica_at; // replica at every slot
+		std::unique_ptr<std::atomic<int>[]> slot_of; // slot of every replica
+		std::unique_ptr<std::atomic<int>[]> energies; // current makespan of every replica
+		std::unique_ptr<std::atomic<bool>[]> claimed; // slots an exchange is in progress on
+		std::atomic<long> exchange_attempts = 0;
+		std::atomic<long> exchanges = 0;
+
+		// portfolio: improvements are offered to the shared incumbent
+		jssp::SharedIncumbent* shared_incumbent = nullptr;
+
+		std::atomic<int> best_makespan = std::numeric_limits<int>::max();
+		jssp::Schedule best_schedule;
+		// guards best_schedule so the best solution can be read while a run is in progress
+		std::mutex best_mutex;
+		std::mt19937 random_engine;
+
+		ParallelTempering(jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines),
+			random_engine(std::random_device()()) {
+			std::vector<int> machine_loads(number_of_machines, 0);
+			for (auto& job : jobs) {
+				int work = 0;
+				for (auto& task : job) {
+					work += task.time;
+					machine_loads[task.machine] += task.time;
+				}
+				lower_bound = std::max(lower_bound, work);
+			}
+			lower_bound = std::max(lower_bound, *std::max_element(machine_loads.begin(), machine_loads.end()));
+		}
+
+		void set_steps(long steps) {
+			this->steps = steps;
+		}
+		void set_number_of_threads(int number_of_threads) {
+			this->number_of_threads = number_of_threads;
+		}
+		void set_temperatures(float min_temperature, float max_temperature) {
+			this->min_temperature = min_temperature;
+			this->max_temperature = std::max(min_temperature, max_temperature);
+		}
+		void set_exchange_interval(int exchange_interval) {
+			this->exchange_interval = std::max(1, exchange_interval);
+		}
+		void set_neighborhood(local_search::Neighborhood neighborhood) {
+			this->neighborhood = neighborhood;
+		}
+		// schedule every replica starts from, by default the one of the shortest starting time rule
+		void set_initial_schedule(const jssp::Schedule& initial_schedule) {
+			this->initial_schedule = initial_schedule;
+		}
+		void set_shared_incumbent(jssp::SharedIncumbent* shared_incumbent) {
+			this->shared_incumbent = shared_incumbent;
+		}
+		void set_seed(unsigned seed) {
+			random_engine.seed(seed);
+		}
+
+		int number_of_replicas() const {
+			int replicas = number_of_threads > 0 ? number_of_threads : std::thread::hardware_concurrency();
+			return std::max(1, replicas);
+		}
+
+		void offer(const graph::DisjunctiveGraph& graph) {
+			if (graph.makespan >= best_makespan.load(std::memory_order_relaxed))
+				return;
+			auto schedule = graph.get_schedule();
+			{
+				std::lock_guard lock(best_mutex);
+				if (graph.makespan >= best_makespan.load(std::memory_order_relaxed))
+					return;
+				best_schedule = schedule;
+				best_makespan.store(graph.makespan, std::memory_order_relaxed);
+			}
+			// outside the lock, the callback may read the best schedule
+			report_improvement(graph.makespan);
+			if (shared_incumbent != nullptr and graph.makespan < shared_incumbent->get())
+				shared_incumbent->offer(graph.makespan, std::move(schedule));
+		}
+
+		// the replica tries to swap its slot with a random neighboring one
+		void try_exchange(int replica, std::mt19937& engine) {
+			int replicas = number_of_replicas();
+			if (replicas < 2)
+				return;
+			int slot = slot_of[replica].load(std::memory_order_acquire);
+			int other_slot = slot == 0 ? 1 : slot == replicas - 1 ? slot - 1 : slot + (engine() % 2 ? 1 : -1);
+			int first = std::min(slot, other_slot);
+			int second = std::max(slot, other_slot);
+			bool expected = false;
+			if (not claimed[first].compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return;
+			expected = false;
+			if (not claimed[second].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+				claimed[first].store(false, std::memory_order_release);
+				return;
+			}
+			// another replica may have taken this one's slot before the claim
+			if (replica_at[slot].load(std::memory_order_relaxed) != replica) {
+				claimed[second].store(false, std::memory_order_release);
+				claimed[first].store(false, std::memory_order_release);
+				return;
+			}
+			exchange_attempts.fetch_add(1, std::memory_order_relaxed);
+			int other = replica_at[other_slot].load(std::memory_order_relaxed);
+			// a lower makespan always goes to the colder slot, a higher one with probability
+			// exp((1 / t_slot - 1 / t_other) * (e_replica - e_other))
+			float exponent = (1.f / temperatures[slot] - 1.f / temperatures[other_slot]) *
+				(energies[replica].load(std::memory_order_relaxed) - energies[other].load(std::memory_order_relaxed));
+			if (exponent >= 0.f or std::uniform_real_distribution<float>(0.f, 1.f)(engine) < std::exp(exponent)) {
+				replica_at[slot].store(other, std::memory_order_relaxed);
+				replica_at[other_slot].store(replica, std::memory_order_relaxed);
+				slot_of[replica].store(other_slot, std::memory_order_release);
+				slot_of[other].store(slot, std::memory_order_release);
+				exchanges.fetch_add(1, std::memory_order_relaxed);
+			}
+			claimed[second].store(false, std::memory_order_release);
+			claimed[first].store(false, std::memory_order_release);
+		}
+
+		void run_replica(int replica, unsigned seed) {
+			local_search::LocalSearch search(jobs, number_of_machines);
+			search.set_neighborhood(neighborhood);
+			auto& graph = search.graph;
+			graph.set_schedule(initial_schedule);
+			std::mt19937 engine(seed);
+			std::uniform_real_distribution<float> uniform(0.f, 1.f);
+			for (long step = 0; step < steps and best_makespan.load(std::memory_order_relaxed) > lower_bound and not should_stop(); ++step) {
+				if (step % exchange_interval == 0)
+					try_exchange(replica, engine);
+				auto path = graph.critical_path();
+				search.generate_moves(path);
+				// counted before the moves are checked so that a replica without moves still spends the budget. the
+				// replicas only end at the lower bound, n5 has no move either on a critical path of a single block
+				count_evaluation();
+				if (search.moves.empty())
+					continue;
+				auto move = search.moves[engine() % search.moves.size()];
+				float temperature = temperatures[slot_of[replica].load(std::memory_order_acquire)];
+				// metropolis: the move is accepted if its makespan is under the threshold
+				float threshold = graph.makespan - temperature * std::log(1.f - uniform(engine));
+				if (search.estimate(move.operation, move.prev) > threshold)
+					continue;
+				int old_prev = graph.machine_prev[move.operation];
+				if (not graph.move_after(move.operation, move.prev))
+					continue;
+				if (graph.makespan > threshold) {
+					graph.move_after(move.operation, old_prev);
+					continue;
+				}
+				energies[replica].store(graph.makespan, std::memory_order_relaxed);
+				offer(graph);
+			}
+		}
+
+		// runs the replicas side by side and returns the best schedule, best_makespan holds its makespan
+		jssp::Schedule run() {
+			start_limits();
+			if (initial_schedule.empty())
+				initial_schedule = jssp::generate_schedule_shortest_starting_time(jobs, number_of_machines);
+			int initial_makespan = jssp::makespan_schedule(initial_schedule, jobs.size(), number_of_machines);
+			{
+				std::lock_guard lock(best_mutex);
+				best_schedule = initial_schedule;
+				best_makespan = initial_makespan;
+			}
+			report_improvement(initial_makespan);
+
+			int replicas = number_of_replicas();
+			temperatures.resize(replicas);
+			for (int slot = 0; slot < replicas; ++slot) {
+				float ratio = replicas == 1 ? 0.f : float(slot) / (replicas - 1);
+				temperatures[slot] = initial_makespan * min_temperature * std::pow(max_temperature / min_temperature, ratio);
+			}
+			replica_at = std::make_unique<std::atomic<int>[]>(replicas);
+			slot_of = std::make_unique<std::atomic<int>[]>(replicas);
+			energies = std::make_unique<std::atomic<int>[]>(replicas);
+			claimed = std::make_unique<std::atomic<bool>[]>(replicas);
+			for (int replica = 0; replica < replicas; ++replica) {
+				replica_at[replica] = replica;
+				slot_of[replica] = replica;
+				energies[replica] = initial_makespan;
+				claimed[replica] = false;
+			}
+
+			std::vector<std::thread> thread_pool;
+			for (int replica = 1; replica < replicas; ++replica)
+				thread_pool.emplace_back([&, replica, seed = random_engine()] { run_replica(replica, seed); });
+			run_replica(0, random_engine());
+			for (auto& thread : thread_pool)
+				thread.join();
+			return get_best_schedule();
+		}
+
+		int get_best_makespan() {
+			return best_makespan.load(std::memory_order_relaxed);
+		}
+
+		// safe to call from another thread while run is in progress
+		jssp::Schedule get_best_schedule() {
+			std::lock_guard lock(best_mutex);
+			return best_schedule;
+		}
+	};
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include "jssp.cpp"
+
+namespace archive {
+
+	// jobs of the tasks on every machine, in order. two schedules with the same sequences have the same semi-active
+	// schedule, whatever the order of their tasks
+	using Sequences = std::vector<std::vector<int>>;
+
+	// like bnb.cpp, only the jobs of the tasks are read, the k-th task of a job in the schedule is its task of index k
+	Sequences machine_sequences(const jssp::Jobs& jobs, int number_of_machines, const jssp::Schedule& schedule) {
+		Sequences sequences(number_of_machines);
+		std::vector<int> task_indices(jobs.size(), 0);
+		for (auto& task : schedule)
+			sequences[jobs[task.job][task_indices[task.job]++].machine].push_back(task.job);
+		return sequences;
+	}
+
+	// 64-bit hash of the sequences (splitmix64 finalizer folded over the jobs, machine after machine)
+	uint64_t hash_sequences(const Sequences& sequences) {
+		uint64_t hash = 0x9e3779b97f4a7c15ull ^ sequences.size();
+		for (auto& sequence : sequences) {
+			for (int job : sequence) {
+				hash ^= uint64_t(job) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+				hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+				hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+				hash ^= hash >> 31;
+			}
+			hash = hash * 31 + sequence.size();
+		}
+		return hash;
+	}
+
+	// pairs of jobs in a different order on a machine, summed over the machines: the number of disjunctive arcs the
+	// two schedules orient differently. every job is expected on every machine at most once
+	int distance(const Sequences& a, const Sequences& b, int number_of_jobs) {
+		std::vector<int> positions(number_of_jobs);
+		int result = 0;
+		for (int machine = 0; machine < a.size(); ++machine) {
+			for (int i = 0; i < b[machine].size(); ++i)
+				positions[b[machine][i]] = i;
+			auto& sequence = a[machine];
+			for (int i = 0; i < sequence.size(); ++i)
+				for (int k = i + 1; k < sequence.size(); ++k)
+					result += positions[sequence[i]] > positions[sequence[k]];
+		}
+		return result;
+	}
+
+	struct Entry {
+		int makespan;
+		uint64_t hash;
+		jssp::Schedule schedule;
+		Sequences sequences;
+	};
+
+	// bounded archive of the best distinct schedules found by the solvers that share it. schedules are deduplicated
+	// by the hash of their machine sequences, and a schedule closer than min_distance to archived ones only gets in
+	// if it is better than all of them, and then replaces them. offers are serialized by a mutex, but one that can't
+	// get in is most of the time rejected on the atomic threshold without locking. entries are immutable and handed
+	// out as shared pointers, a reader keeps its snapshot however the archive changes afterwards
+	struct EliteArchive {
+
+		const jssp::Jobs& jobs;
+		int number_of_machines;
+		int capacity;
+		int min_distance; // 0 only rejects schedules with the same machine sequences
+
+		std::vector<std::shared_ptr<const Entry>> entries; // best first, guarded by mutex
+		mutable std::mutex mutex;
+		std::atomic<int> threshold = std::numeric_limits<int>::max(); // makespan of the worst entry once it is full
+		std::atomic<long> offers = 0;
+		std::atomic<long> insertions = 0;
+
+		EliteArchive(const jssp::Jobs& jobs, int number_of_machines, int capacity = 16, int min_distance = 0) :
+			jobs(jobs), number_of_machines(number_of_machines), capacity(std::max(1, capacity)), min_distance(min_distance) {}
+
+		// whether a schedule of this makespan may get in, cheap enough to be checked before building the schedule
+		bool accepts(int makespan) const {
+			return makespan < threshold.load(std::memory_order_acquire);
+		}
+
+		// returns true if the schedule got in
+		bool offer(int makespan, const jssp::Schedule& schedule) {
+			offers.fetch_add(1, std::memory_order_relaxed);
+			if (not accepts(makespan))
+				return false;
+			auto sequences = machine_sequences(jobs, number_of_machines, schedule);
+			uint64_t hash = hash_sequences(sequences);
+
+			std::lock_guard lock(mutex);
+			if (makespan >= threshold.load(std::memory_order_relaxed))
+				return false;
+			std::vector<int> close; // indices of the entries the schedule is too close to
+			for (int i = 0; i < entries.size(); ++i) {
+				auto& entry = *entries[i];
+				bool duplicate = entry.hash == hash and entry.sequences == sequences;
+				if (duplicate or (min_distance > 0 and distance(entry.sequences, sequences, jobs.size()) < min_distance)) {
+					if (entry.makespan <= makespan)
+						return false;
+					close.push_back(i);
+				}
+			}
+			for (int i = close.size() - 1; i >= 0; --i)
+				entries.erase(entries.begin() + close[i]);
+
+			auto entry = std::make_shared<const Entry>(makespan, hash, schedule, std::move(sequences));
+			auto position = std::upper_bound(entries.begin(), entries.end(), makespan, [](int makespan, auto& entry) {
+				return makespan < entry->makespan;
+			});
+			entries.insert(position, std::move(entry));
+			if (entries.size() > capacity)
+				entries.pop_back();
+			threshold.store(entries.size() == capacity ? entries.back()->makespan : std::numeric_limits<int>::max(), std::memory_order_release);
+			insertions.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// snapshot of the entries, best first
+		std::vector<std::shared_ptr<const Entry>> get_entries() const {
+			std::lock_guard lock(mutex);
+			return entries;
+		}
+		// null while the archive is empty
+		std::shared_ptr<const Entry> best() const {
+			std::lock_guard lock(mutex);
+			return entries.empty() ? nullptr : entries.front();
+		}
+		int size() const {
+			std::lock_guard lock(mutex);
+			return entries.size();
+		}
+		void clear() {
+			std::lock_guard lock(mutex);
+			entries.clear();
+			threshold.store(std::numeric_limits<int>::max(), std::memory_order_release);
+		}
+	};
+
+}
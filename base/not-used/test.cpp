@@ -0,0 +1,11 @@
+
+
+struct A {
+	[[nodiscard]] constexpr operator int() const noexcept {
+		return 0;
+	}
+};
+
+int main() {
+	A a;
+}
\ No newline at end of file
@@ -0,0 +1,275 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <barrier>
+#include <cstdint>
+#include <limits>
+#include "util.cpp"
+#include "jssp.cpp"
+
+namespace beam {
+
+	// child of a state of the beam: the parent with the next task of job appended. children are ranked by the idle time
+	// the machines accumulated and then by their lower bound. the lower bound alone ranks too many children the same
+	// and favors the ones that put the hard decisions off
+	struct Candidate {
+		int idle_time;
+		int lower_bound;
+		uint64_t hash; // equal for the children that reach the same state through different orders
+		int parent;
+		int job;
+
+		bool operator<(const Candidate& other) const {
+			return std::tie(idle_time, lower_bound, hash) < std::tie(other.idle_time, other.lower_bound, other.hash);
+		}
+	};
+
+	// the states of one depth of the beam in pooled flat buffers, state i owns the stride ints from i * stride: the
+	// next task index of every job, the machine times, the job times and the load left on every machine
+	struct Layer {
+		int number_of_jobs;
+		int number_of_machines;
+		int stride;
+		int size = 0;
+		std::vector<int> data;
+		std::vector<int> lower_bounds;
+		std::vector<int> idle_times;
+		std::vector<uint64_t> hashes;
+
+		void resize(int number_of_jobs, int number_of_machines, int capacity) {
+			this->number_of_jobs = number_of_jobs;
+			this->number_of_machines = number_of_machines;
+			stride = 2 * number_of_jobs + 2 * number_of_machines;
+			data.resize(capacity * stride);
+			lower_bounds.resize(capacity);
+			idle_times.resize(capacity);
+			hashes.resize(capacity);
+		}
+
+		int* task_indices(int state) { return data.data() + state * stride; }
+		int* machine_times(int state) { return task_indices(state) + number_of_jobs; }
+		int* job_times(int state) { return machine_times(state) + number_of_machines; }
+		int* remaining_load(int state) { return job_times(state) + number_of_jobs; }
+	};
+
+	// splitmix64 finalizer
+	uint64_t mix(uint64_t x) {
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return x ^ (x >> 31);
+	}
+	// hash of a state is the xor of the hashes of its jobs (task index, time) and machines (time)
+	uint64_t job_hash(int job, int task_index, int time) {
+		return mix((uint64_t(job) << 48) ^ (uint64_t(task_index) << 32) ^ uint32_t(time));
+	}
+	uint64_t machine_hash(int machine, int time) {
+		return mix((uint64_t(1) << 63) ^ (uint64_t(machine) << 32) ^ uint32_t(time));
+	}
+
+	// beam search over partial schedules built like pso::Pso::build_parameterized_active_schedule: a state branches
+	// on the next tasks of the jobs that can start before sigma + delta * (phi - sigma), where sigma and phi are the
+	// earliest start and the earliest completion among the next tasks. every depth keeps the beam_width best distinct
+	// children. the children are scored and selected without being built, only the kept ones are copied out of their
+	// parent, and both steps are split between the threads
+	struct BeamSearch {
+
+		const jssp::Jobs& jobs;
+		int number_of_machines;
+		int number_of_tasks;
+
+		int beam_width = 64;
+		float delta = 0.5f;
+		int number_of_threads = 0; // 0 means one per hardware thread
+
+		std::vector<std::vector<int>> remaining_work; // processing time of the job from the task index on
+
+		int best_makespan = std::numeric_limits<int>::max();
+
+		BeamSearch(const jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines),
+			number_of_tasks(jobs.size() * number_of_machines), remaining_work(jobs.size()) {
+			for (int job = 0; job < jobs.size(); ++job) {
+				remaining_work[job].assign(jobs[job].size() + 1, 0);
+				for (int index = jobs[job].size() - 1; index >= 0; --index)
+					remaining_work[job][index] = remaining_work[job][index + 1] + jobs[job][index].time;
+			}
+		}
+
+		void set_beam_width(int beam_width) {
+			this->beam_width = std::max(1, beam_width);
+		}
+		void set_delta(float d) {
+			this->delta = std::clamp(d, 0.f, 1.f);
+		}
+		void set_number_of_threads(int number_of_threads) {
+			this->number_of_threads = number_of_threads;
+		}
+
+		int number_of_workers() const {
+			int workers = number_of_threads > 0 ? number_of_threads : std::thread::hardware_concurrency();
+			return std::max(1, workers);
+		}
+
+		// appends the children of the state to candidates
+		void expand(Layer& layer, int state, std::vector<Candidate>& candidates) const {
+			int* task_indices = layer.task_indices(state);
+			int* machine_times = layer.machine_times(state);
+			int* job_times = layer.job_times(state);
+			int* remaining_load = layer.remaining_load(state);
+
+			int sigma_star = std::numeric_limits<int>::max();
+			int phi_star = std::numeric_limits<int>::max();
+			for (int job = 0; job < jobs.size(); ++job) {
+				if (task_indices[job] == jobs[job].size())
+					continue;
+				auto& task = jobs[job][task_indices[job]];
+				int start_time = std::max(job_times[job], machine_times[task.machine]);
+				sigma_star = std::min(sigma_star, start_time);
+				phi_star = std::min(phi_star, start_time + task.time);
+			}
+
+			for (int job = 0; job < jobs.size(); ++job) {
+				if (task_indices[job] == jobs[job].size())
+					continue;
+				int index = task_indices[job];
+				auto& task = jobs[job][index];
+				int start_time = std::max(job_times[job], machine_times[task.machine]);
+				if (start_time > sigma_star + delta * (phi_star - sigma_star))
+					continue;
+				int end_time = start_time + task.time;
+				// the job and machine bounds of the other jobs and machines don't change
+				int lower_bound = std::max({layer.lower_bounds[state], end_time + remaining_work[job][index + 1],
+					end_time + remaining_load[task.machine] - task.time});
+				uint64_t hash = layer.hashes[state] ^ job_hash(job, index, job_times[job]) ^ job_hash(job, index + 1, end_time) ^
+					machine_hash(task.machine, machine_times[task.machine]) ^ machine_hash(task.machine, end_time);
+				int idle_time = layer.idle_times[state] + start_time - machine_times[task.machine];
+				candidates.push_back({idle_time, lower_bound, hash, state, job});
+			}
+		}
+
+		// writes the child of the candidate at position child of the layer
+		void build_child(Layer& parents, Layer& children, int child, const Candidate& candidate) const {
+			std::copy_n(parents.task_indices(candidate.parent), parents.stride, children.task_indices(child));
+			int* task_indices = children.task_indices(child);
+			int* machine_times = children.machine_times(child);
+			int* job_times = children.job_times(child);
+			int* remaining_load = children.remaining_load(child);
+
+			auto& task = jobs[candidate.job][task_indices[candidate.job]];
+			int end_time = std::max(job_times[candidate.job], machine_times[task.machine]) + task.time;
+			machine_times[task.machine] = end_time;
+			job_times[candidate.job] = end_time;
+			remaining_load[task.machine] -= task.time;
+			task_indices[candidate.job]++;
+			children.lower_bounds[child] = candidate.lower_bound;
+			children.idle_times[child] = candidate.idle_time;
+			children.hashes[child] = candidate.hash;
+		}
+
+		// builds the schedule of the best complete state and returns it, best_makespan holds its makespan
+		jssp::Schedule run() {
+			int workers = number_of_workers();
+			std::vector<Layer> layers(2);
+			for (auto& layer : layers)
+				layer.resize(jobs.size(), number_of_machines, beam_width);
+
+			// root: the empty schedule
+			Layer* parents = &layers[0];
+			Layer* children = &layers[1];
+			parents->size = 1;
+			std::fill_n(parents->data.begin(), parents->stride, 0);
+			uint64_t root_hash = 0;
+			int root_bound = 0;
+			for (int job = 0; job < jobs.size(); ++job) {
+				root_hash ^= job_hash(job, 0, 0);
+				root_bound = std::max(root_bound, remaining_work[job][0]);
+			}
+			for (int machine = 0; machine < number_of_machines; ++machine) {
+				root_hash ^= machine_hash(machine, 0);
+				for (auto& job : jobs)
+					for (auto& task : job)
+						if (task.machine == machine)
+							parents->remaining_load(0)[machine] += task.time;
+				root_bound = std::max(root_bound, parents->remaining_load(0)[machine]);
+			}
+			parents->lower_bounds[0] = root_bound;
+			parents->idle_times[0] = 0;
+			parents->hashes[0] = root_hash;
+
+			// the parent and the job of every kept state of every depth, to rebuild the schedule at the end
+			std::vector<int> history_parents(number_of_tasks * beam_width);
+			std::vector<int> history_jobs(number_of_tasks * beam_width);
+			std::vector<std::vector<Candidate>> worker_candidates(workers);
+			std::vector<Candidate> selected;
+			int depth = 0;
+			bool selecting = true;
+
+			// runs on a single thread between the two parallel steps of every depth: after the expansion it merges the
+			// candidates of the workers and keeps the best beam_width distinct ones, after the copy it swaps the layers
+			auto step = [&]() noexcept {
+				if (selecting) {
+					selected.clear();
+					for (auto& candidates : worker_candidates)
+						selected.insert(selected.end(), candidates.begin(), candidates.end());
+					// duplicates are adjacent once sorted, a few more candidates than the width make up for them
+					size_t kept = std::min(selected.size(), size_t(2 * beam_width));
+					std::nth_element(selected.begin(), selected.begin() + kept - 1, selected.end());
+					std::sort(selected.begin(), selected.begin() + kept);
+					selected.resize(kept);
+					selected.erase(std::unique(selected.begin(), selected.end(), [](const Candidate& a, const Candidate& b) {
+						return a.hash == b.hash;
+					}), selected.end());
+					if (selected.size() > beam_width)
+						selected.resize(beam_width);
+					children->size = selected.size();
+					for (int i = 0; i < selected.size(); ++i) {
+						history_parents[depth * beam_width + i] = selected[i].parent;
+						history_jobs[depth * beam_width + i] = selected[i].job;
+					}
+				} else {
+					std::swap(parents, children);
+					depth++;
+				}
+				selecting = not selecting;
+			};
+			std::barrier barrier(workers, step);
+
+			auto work = [&](int worker) {
+				auto& candidates = worker_candidates[worker];
+				candidates.reserve(beam_width * jobs.size() / workers + jobs.size());
+				for (int d = 0; d < number_of_tasks; ++d) {
+					candidates.clear();
+					for (int state = parents->size * worker / workers; state < parents->size * (worker + 1) / workers; ++state)
+						expand(*parents, state, candidates);
+					barrier.arrive_and_wait();
+					for (int child = selected.size() * worker / workers; child < selected.size() * (worker + 1) / workers; ++child)
+						build_child(*parents, *children, child, selected[child]);
+					barrier.arrive_and_wait();
+				}
+			};
+
+			std::vector<std::thread> thread_pool;
+			for (int worker = 1; worker < workers; ++worker)
+				thread_pool.emplace_back(work, worker);
+			work(0);
+			for (auto& thread : thread_pool)
+				thread.join();
+
+			// every state is complete, its lower bound is its makespan
+			int best = std::min_element(parents->lower_bounds.begin(), parents->lower_bounds.begin() + parents->size) - parents->lower_bounds.begin();
+			best_makespan = parents->lower_bounds[best];
+
+			std::vector<int> choices(number_of_tasks);
+			for (int d = number_of_tasks - 1; d >= 0; --d) {
+				choices[d] = history_jobs[d * beam_width + best];
+				best = history_parents[d * beam_width + best];
+			}
+			jssp::Schedule schedule;
+			std::vector<int> task_indices(jobs.size(), 0);
+			for (int job : choices)
+				schedule.push_back(jobs[job][task_indices[job]++]);
+			return schedule;
+		}
+	};
+
+}
@@ -0,0 +1,876 @@
+#pragma once
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <ranges>
+#include <random>
+#include <fstream>
+#include <queue>
+#include <tuple>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <bit>
+
+#include "util.cpp"
+#include "jssp.cpp"
+
+enum class SearchOrder {
+	depth_first, // children in job order
+	limited_discrepancy, // children by earliest start then earliest end, with 0, 1, 2... departures from that order
+	best_first, // open nodes by lower bound, the deepest first among equal bounds
+};
+
+// admissible bounds used to prune the search, makespan is the partial makespan the search always prunes with
+struct DfsOptions {
+	bool job_bound = true; // time of the job plus its remaining work
+	bool machine_bound = true; // time of the machine, or earliest head, plus its remaining load plus the smallest tail
+	bool jackson_bound = false; // preemptive one-machine schedule of the remaining tasks with their heads and tails
+	bool active_branching = true; // branch only on the giffler-thompson conflict set, which yields active schedules only
+	size_t transposition_table_size = 1 << 16; // slots per worker of the table of dominated states, 0 disables it
+	int min_split_tasks = 10; // parallel search: subtrees with fewer tasks left are never handed to another worker
+	// order of dfs_optimized, the parallel search is always depth first. limited discrepancy search doesn't use the
+	// transposition table, a state pruned with fewer discrepancies left could be revisited with more
+	SearchOrder order = SearchOrder::depth_first;
+	size_t best_first_nodes = 1 << 20; // best first: nodes kept in memory, the nodes that don't fit are searched depth first
+
+	// anytime search: the time budget, cancel token and improvement callback of the limits are used, and every
+	// explored node counts as an evaluation. the callback may be called from several workers at once
+	util::SearchLimits* limits = nullptr;
+	int upper_bound = std::numeric_limits<int>::max(); // only schedules with a smaller makespan are searched for
+	jssp::Schedule initial_schedule; // incumbent to start from, from a dispatching rule or pso::Pso::get_best_schedule
+	// portfolio: the search also prunes with the makespan of the shared incumbent, offers it every schedule it
+	// improves on and proves it optimal when the whole tree was searched
+	jssp::SharedIncumbent* shared_incumbent = nullptr;
+
+	// subproblem of a larger schedule, for the large neighborhood search. every vector may be left empty
+	std::vector<int> machine_release_times; // the machines are busy until then
+	std::vector<int> job_release_times; // the jobs can't start before
+	std::vector<int> job_delivery_times; // time the job still needs after its last task, counted in the makespan
+	std::vector<int> machine_delivery_times; // same for the last task of the machine
+	std::vector<std::vector<int>> machine_orders; // jobs in the order they must use the machine, empty for a free machine
+};
+
+// nodes explored between two checks of the limits
+constexpr int limits_check_interval = 1024;
+
+struct DfsStats {
+	enum Bound { makespan, job, machine, jackson, ancestor, transposition, count };
+
+	long nodes = 0;
+	long pruned[Bound::count] = {};
+
+	DfsStats& operator+=(const DfsStats& other) {
+		nodes += other.nodes;
+		for (int bound = 0; bound < Bound::count; ++bound)
+			pruned[bound] += other.pruned[bound];
+		return *this;
+	}
+
+	void print() const {
+		static const char* names[] = {"makespan", "job bound", "machine bound", "jackson bound", "ancestor bound", "transposition table"};
+		util::println("Nodes: {}", nodes);
+		for (int bound = 0; bound < Bound::count; ++bound)
+			util::println("  pruned by {}: {} ({:.2f}%)", names[bound], pruned[bound], nodes == 0 ? 0. : 100. * pruned[bound] / nodes);
+	}
+};
+
+// fixed-size table from the zobrist hash of the jobs' progress to the machine and job times of a state with that
+// progress. a state with the same progress whose times are all at least the stored ones is dominated, every schedule
+// it leads to can be reached from the stored state with no task ending later, so the search doesn't need to explore it
+struct TranspositionTable {
+	int profile_size = 0;
+	std::vector<uint64_t> keys; // 0 for an empty slot
+	std::vector<int> profiles; // machine times then job times of the state of every slot
+	uint64_t index_mask = 0;
+
+	// the size is rounded up to a power of two, 0 disables the table
+	void resize(size_t size, int profile_size) {
+		size_t capacity = size == 0 ? 0 : std::bit_ceil(size);
+		this->profile_size = profile_size;
+		keys.assign(capacity, 0);
+		profiles.assign(capacity * profile_size, 0);
+		index_mask = capacity == 0 ? 0 : capacity - 1;
+	}
+	bool enabled() const {
+		return not keys.empty();
+	}
+
+	// returns true if the state is dominated by the stored one, otherwise the state replaces it
+	bool dominated(uint64_t key, const std::vector<int>& machine_times, const std::vector<int>& job_times) {
+		size_t slot = key & index_mask;
+		int* profile = profiles.data() + slot * profile_size;
+		if (keys[slot] == key) {
+			bool dominated = std::equal(machine_times.begin(), machine_times.end(), profile, std::greater_equal<int>{}) and
+				std::equal(job_times.begin(), job_times.end(), profile + machine_times.size(), std::greater_equal<int>{});
+			if (dominated)
+				return true;
+		}
+		keys[slot] = key;
+		std::copy(machine_times.begin(), machine_times.end(), profile);
+		std::copy(job_times.begin(), job_times.end(), profile + machine_times.size());
+		return false;
+	}
+};
+
+// incremental state of a partial schedule: pushing a task updates the machine and job times in O(1) and records
+// what it overwrote in the undo log, so that popping it restores them in O(1) without re-simulating the schedule
+struct SearchState {
+	struct Undo {
+		int machine_time;
+		int job_time;
+		int makespan;
+		int lower_bound;
+	};
+
+	const jssp::Jobs& jobs;
+	int number_of_machines;
+	int number_of_tasks;
+	std::vector<int> machine_times;
+	std::vector<int> job_times;
+	std::vector<int> last_task_indices;
+	std::vector<int> choices; // job of every scheduled task, in order
+	std::vector<Undo> undo_log;
+	int makespan = 0;
+
+	// bounds data: static heads and tails of the tasks inside their job, and what is left to schedule
+	std::vector<std::vector<int>> job_heads; // processing time of the tasks before the task in its job
+	std::vector<std::vector<int>> job_tails; // processing time of the tasks after the task in its job
+	std::vector<std::vector<int>> machine_task_indices; // index of the task of each job on each machine, -1 if none
+	std::vector<int> remaining_work;
+	std::vector<int> remaining_load;
+	// subproblem constraints, see DfsOptions
+	std::vector<int> job_delivery_times;
+	std::vector<int> machine_delivery_times;
+	std::vector<std::vector<int>> machine_orders;
+	std::vector<int> machine_positions; // number of tasks scheduled on the machine
+	// best bound of the node, bounds only grow along a branch so it is the max of the bounds of the node and its ancestors
+	int lower_bound = 0;
+	std::vector<std::tuple<int, int, int>> jackson_tasks; // scratch for jackson_bound
+
+	// zobrist hash of the jobs' progress, xor of a random key per (job, number of scheduled tasks)
+	std::vector<std::vector<uint64_t>> zobrist_keys;
+	uint64_t hash = 0;
+	TranspositionTable transposition_table;
+
+	SearchState(const jssp::Jobs& jobs, int number_of_machines, size_t transposition_table_size = 0) : jobs(jobs), number_of_machines(number_of_machines),
+		number_of_tasks(0), machine_times(number_of_machines, 0), job_times(jobs.size(), 0),
+		last_task_indices(jobs.size(), 0), job_heads(jobs.size()), job_tails(jobs.size()),
+		machine_task_indices(jobs.size(), std::vector<int>(number_of_machines, -1)), remaining_work(jobs.size(), 0),
+		remaining_load(number_of_machines, 0), job_delivery_times(jobs.size(), 0), machine_delivery_times(number_of_machines, 0), machine_positions(number_of_machines, 0) {
+		for (auto& job : jobs)
+			number_of_tasks += job.size();
+		choices.reserve(number_of_tasks);
+		undo_log.reserve(number_of_tasks);
+
+		for (int job = 0; job < jobs.size(); ++job) {
+			for (auto& task : jobs[job]) {
+				job_heads[job].push_back(remaining_work[job]);
+				remaining_work[job] += task.time;
+				remaining_load[task.machine] += task.time;
+				machine_task_indices[job][task.machine] = task.index;
+			}
+			for (auto& task : jobs[job])
+				job_tails[job].push_back(remaining_work[job] - job_heads[job][task.index] - task.time);
+		}
+		for (int job = 0; job < jobs.size(); ++job)
+			lower_bound = std::max(lower_bound, job_bound(job));
+		for (int machine = 0; machine < number_of_machines; ++machine)
+			lower_bound = std::max(lower_bound, machine_bound(machine));
+
+		std::mt19937_64 engine(jobs.size() * number_of_machines);
+		zobrist_keys.resize(jobs.size());
+		for (int job = 0; job < jobs.size(); ++job) {
+			for (int progress = 0; progress <= jobs[job].size(); ++progress)
+				zobrist_keys[job].push_back(engine() | 1);
+			hash ^= zobrist_keys[job][0];
+		}
+		transposition_table.resize(transposition_table_size, number_of_machines + jobs.size());
+	}
+
+	// turns the root into the subproblem described by the options: the machines and jobs start at their release
+	// times, the delivery times follow their last task and the fixed machine orders restrict can_push. the tasks of
+	// the jobs must be indexed from 0 inside their job, a job or a machine may have none
+	void set_subproblem(const DfsOptions& options) {
+		if (not options.machine_release_times.empty())
+			machine_times = options.machine_release_times;
+		if (not options.job_release_times.empty())
+			job_times = options.job_release_times;
+		if (not options.job_delivery_times.empty()) {
+			job_delivery_times = options.job_delivery_times;
+			for (int job = 0; job < jobs.size(); ++job) {
+				remaining_work[job] += job_delivery_times[job];
+				for (int& tail : job_tails[job])
+					tail += job_delivery_times[job];
+			}
+		}
+		if (not options.machine_delivery_times.empty())
+			machine_delivery_times = options.machine_delivery_times;
+		machine_orders = options.machine_orders;
+		// the jobs and machines without tasks are done from the root on
+		for (int job = 0; job < jobs.size(); ++job)
+			if (jobs[job].empty())
+				makespan = std::max(makespan, job_times[job] + job_delivery_times[job]);
+		for (int machine = 0; machine < number_of_machines; ++machine)
+			if (remaining_load[machine] == 0)
+				makespan = std::max(makespan, machine_times[machine] + machine_delivery_times[machine]);
+		lower_bound = makespan;
+		for (int job = 0; job < jobs.size(); ++job)
+			lower_bound = std::max(lower_bound, job_bound(job));
+		for (int machine = 0; machine < number_of_machines; ++machine)
+			lower_bound = std::max(lower_bound, machine_bound(machine));
+	}
+
+	// giffler-thompson: the earliest completion among the next tasks of the jobs and the machine of that task
+	std::pair<int, int> critical_machine() const {
+		int machine = -1;
+		int completion = std::numeric_limits<int>::max();
+		for (int job = 0; job < jobs.size(); ++job) {
+			if (not can_push(job))
+				continue;
+			auto& task = jobs[job][last_task_indices[job]];
+			int end_time = std::max(machine_times[task.machine], job_times[job]) + task.time;
+			if (end_time < completion) {
+				completion = end_time;
+				machine = task.machine;
+			}
+		}
+		return {machine, completion};
+	}
+	// the conflict set is the next tasks on the critical machine that can start before the earliest completion
+	bool in_conflict_set(int job, int machine, int completion) const {
+		auto& task = jobs[job][last_task_indices[job]];
+		return task.machine == machine and std::max(machine_times[machine], job_times[job]) < completion;
+	}
+
+	bool dominated() {
+		return transposition_table.enabled() and transposition_table.dominated(hash, machine_times, job_times);
+	}
+
+	// machine of the last pushed task
+	int last_machine() const {
+		int job = choices.back();
+		return jobs[job][last_task_indices[job] - 1].machine;
+	}
+
+	int job_bound(int job) const {
+		return job_times[job] + remaining_work[job];
+	}
+
+	// the remaining tasks of the machine can't start before the machine is free nor before the earliest of their
+	// heads, and the last one is followed by at least the smallest of their tails and the delivery of the machine
+	int machine_bound(int machine) const {
+		int min_head = std::numeric_limits<int>::max();
+		int min_tail = std::numeric_limits<int>::max();
+		for (int job = 0; job < jobs.size(); ++job) {
+			int index = machine_task_indices[job][machine];
+			int next = last_task_indices[job];
+			if (index < next)
+				continue;
+			min_head = std::min(min_head, job_times[job] + job_heads[job][index] - job_heads[job][next]);
+			min_tail = std::min(min_tail, job_tails[job][index]);
+		}
+		if (remaining_load[machine] == 0)
+			return machine_times[machine];
+		return std::max(machine_times[machine], min_head) + remaining_load[machine] + std::max(min_tail, machine_delivery_times[machine]);
+	}
+
+	// makespan of the preemptive schedule of the remaining tasks of the machine (release = head, delivery = tail)
+	// that always runs the released task with the largest tail, it is optimal for the preemptive one-machine problem
+	int jackson_bound(int machine) {
+		jackson_tasks.clear();
+		for (int job = 0; job < jobs.size(); ++job) {
+			int index = machine_task_indices[job][machine];
+			int next = last_task_indices[job];
+			if (index < next)
+				continue;
+			int head = std::max(machine_times[machine], job_times[job] + job_heads[job][index] - job_heads[job][next]);
+			jackson_tasks.emplace_back(head, jobs[job][index].time, job_tails[job][index]);
+		}
+		std::sort(jackson_tasks.begin(), jackson_tasks.end());
+
+		// released tasks as (tail, remaining processing time), largest tail first
+		std::priority_queue<std::pair<int, int>> released;
+		int bound = machine_times[machine];
+		int time = 0;
+		int i = 0;
+		while (i < jackson_tasks.size() or not released.empty()) {
+			if (released.empty())
+				time = std::max(time, std::get<0>(jackson_tasks[i]));
+			while (i < jackson_tasks.size() and std::get<0>(jackson_tasks[i]) <= time) {
+				released.emplace(std::get<2>(jackson_tasks[i]), std::get<1>(jackson_tasks[i]));
+				i++;
+			}
+			auto [tail, left] = released.top();
+			released.pop();
+			// run the task until it completes or the next task is released
+			int next_release = i < jackson_tasks.size() ? std::get<0>(jackson_tasks[i]) : std::numeric_limits<int>::max();
+			int run = std::min(left, next_release - time);
+			time += run;
+			if (run == left)
+				bound = std::max(bound, time + tail);
+			else
+				released.emplace(tail, left - run);
+		}
+		if (not jackson_tasks.empty())
+			bound = std::max(bound, time + machine_delivery_times[machine]);
+		return bound;
+	}
+
+	bool can_push(int job) const {
+		if (last_task_indices[job] == jobs[job].size())
+			return false;
+		if (machine_orders.empty())
+			return true;
+		int machine = jobs[job][last_task_indices[job]].machine;
+		auto& order = machine_orders[machine];
+		return order.empty() or order[machine_positions[machine]] == job;
+	}
+	bool is_complete() const {
+		return choices.size() == number_of_tasks;
+	}
+
+	// schedules the next task of the job at the end of the partial schedule
+	void push(int job) {
+		auto& task = jobs[job][last_task_indices[job]];
+		undo_log.push_back({machine_times[task.machine], job_times[job], makespan, lower_bound});
+		remaining_work[job] -= task.time;
+		remaining_load[task.machine] -= task.time;
+		int end_time = std::max(machine_times[task.machine], job_times[job]) + task.time;
+		machine_times[task.machine] = end_time;
+		job_times[job] = end_time;
+		machine_positions[task.machine]++;
+		makespan = std::max(makespan, end_time);
+		if (last_task_indices[job] + 1 == jobs[job].size())
+			makespan = std::max(makespan, end_time + job_delivery_times[job]);
+		if (remaining_load[task.machine] == 0)
+			makespan = std::max(makespan, end_time + machine_delivery_times[task.machine]);
+		hash ^= zobrist_keys[job][last_task_indices[job]] ^ zobrist_keys[job][last_task_indices[job] + 1];
+		last_task_indices[job]++;
+		choices.push_back(job);
+	}
+	void pop() {
+		int job = choices.back();
+		choices.pop_back();
+		last_task_indices[job]--;
+		hash ^= zobrist_keys[job][last_task_indices[job]] ^ zobrist_keys[job][last_task_indices[job] + 1];
+		auto& task = jobs[job][last_task_indices[job]];
+		auto& undo = undo_log.back();
+		machine_times[task.machine] = undo.machine_time;
+		job_times[job] = undo.job_time;
+		machine_positions[task.machine]--;
+		makespan = undo.makespan;
+		lower_bound = undo.lower_bound;
+		remaining_work[job] += task.time;
+		remaining_load[task.machine] += task.time;
+		undo_log.pop_back();
+	}
+};
+
+// best solution found by the search. the makespan is atomic so that the workers of the parallel search prune with it
+// without locking, the choices are only copied, under the mutex, when the makespan improves
+struct Incumbent {
+	std::atomic<int> makespan = std::numeric_limits<int>::max();
+	std::mutex mutex;
+	std::vector<int> choices;
+	const jssp::SharedIncumbent* shared = nullptr; // schedules found by other solvers, only its makespan is read
+
+	int get() const {
+		int best = makespan.load(std::memory_order_relaxed);
+		return shared == nullptr ? best : std::min(best, shared->get());
+	}
+	bool offer(int new_makespan, const std::vector<int>& new_choices) {
+		std::lock_guard lock(mutex);
+		if (new_makespan >= get())
+			return false;
+		choices = new_choices;
+		makespan.store(new_makespan, std::memory_order_relaxed);
+		return true;
+	}
+};
+
+struct DfsResult {
+	int makespan; // upper_bound if no better schedule was found
+	jssp::Schedule schedule; // empty if no schedule better than upper_bound was found
+	bool optimal; // the whole tree was searched, nothing better than makespan exists
+	DfsStats stats;
+};
+
+// rebuilds the schedule from the sequence of jobs chosen by the search
+jssp::Schedule schedule_from_choices(const jssp::Jobs& jobs, const std::vector<int>& choices) {
+	jssp::Schedule schedule;
+	std::vector<int> task_indices(jobs.size(), 0);
+	for (int job : choices)
+		schedule.push_back(jobs[job][task_indices[job]++]);
+	return schedule;
+}
+
+// checks the bounds of the node of the last pushed task against the best makespan, from the cheapest to the most
+// expensive, and raises the node's lower bound with the ones it computed. returns the bound that prunes the node
+// or DfsStats::count if the node has to be explored
+int prune_bound(SearchState& state, int best_makespan, const DfsOptions& options) {
+	if (state.makespan >= best_makespan)
+		return DfsStats::makespan;
+	if (state.lower_bound >= best_makespan)
+		return DfsStats::ancestor;
+	int job = state.choices.back();
+	int machine = state.last_machine();
+	if (options.job_bound) {
+		state.lower_bound = std::max(state.lower_bound, state.job_bound(job));
+		if (state.lower_bound >= best_makespan)
+			return DfsStats::job;
+	}
+	if (options.machine_bound) {
+		state.lower_bound = std::max(state.lower_bound, state.machine_bound(machine));
+		if (state.lower_bound >= best_makespan)
+			return DfsStats::machine;
+	}
+	if (options.jackson_bound) {
+		state.lower_bound = std::max(state.lower_bound, state.jackson_bound(machine));
+		if (state.lower_bound >= best_makespan)
+			return DfsStats::jackson;
+	}
+	return DfsStats::count;
+}
+
+// children of a node still to explore: the jobs from next_job on, restricted to the conflict set of the critical
+// machine with active branching
+struct Branch {
+	int next_job;
+	int machine;
+	int completion;
+
+	Branch(const SearchState& state, const DfsOptions& options) : next_job(0), machine(-1), completion(0) {
+		if (options.active_branching)
+			std::tie(machine, completion) = state.critical_machine();
+	}
+	bool can_branch(const SearchState& state, int job) const {
+		return state.can_push(job) and (machine == -1 or state.in_conflict_set(job, machine, completion));
+	}
+};
+
+enum class Visit { expand, skip, stop };
+
+// counts the node of the last pushed task, checks the limits, prunes it with the bounds and the transposition table
+// and offers it to the incumbent if the schedule is complete. the node is only worth expanding if it returns expand
+Visit visit_node(SearchState& state, Incumbent& incumbent, const DfsOptions& options, DfsStats& stats) {
+	stats.nodes++;
+	if (options.limits != nullptr and stats.nodes % limits_check_interval == 0) {
+		options.limits->evaluations.fetch_add(limits_check_interval, std::memory_order_relaxed);
+		if (options.limits->should_stop())
+			return Visit::stop;
+	}
+	int bound = prune_bound(state, incumbent.get(), options);
+	if (bound != DfsStats::count) {
+		stats.pruned[bound]++;
+		return Visit::skip;
+	}
+	if (state.is_complete()) {
+		if (incumbent.offer(state.makespan, state.choices)) {
+			if (options.shared_incumbent != nullptr)
+				options.shared_incumbent->offer(state.makespan, schedule_from_choices(state.jobs, state.choices));
+			if (options.limits != nullptr)
+				options.limits->report_improvement(state.makespan);
+		}
+		return Visit::skip;
+	}
+	if (state.dominated()) {
+		stats.pruned[DfsStats::transposition]++;
+		return Visit::skip;
+	}
+	return Visit::expand;
+}
+
+// iterative depth first search of the subtree rooted at the current state, branches holds for every depth the
+// children left to explore. split is asked about every node that survives pruning and returns true when it took the node's
+// subtree away, for another worker to explore. returns false if the limits stopped the search, the state is then
+// back at the root of the subtree
+bool _dfs_optimized(SearchState& state, Incumbent& incumbent, const DfsOptions& options, DfsStats& stats, auto&& split) {
+	int number_of_jobs = state.jobs.size();
+	std::vector<Branch> branches;
+	branches.reserve(state.number_of_tasks + 1);
+	branches.emplace_back(state, options);
+
+	while (true) {
+		auto& branch = branches.back();
+		int& job = branch.next_job;
+		while (job < number_of_jobs and not branch.can_branch(state, job))
+			job++;
+
+		// every child of the node has been explored
+		if (job == number_of_jobs) {
+			branches.pop_back();
+			if (branches.empty())
+				break;
+			state.pop();
+			continue;
+		}
+
+		state.push(job++);
+		Visit visit = visit_node(state, incumbent, options, stats);
+		if (visit == Visit::stop) {
+			for (int depth = 0; depth < branches.size(); ++depth)
+				state.pop();
+			return false;
+		}
+		if (visit == Visit::skip) {
+			state.pop();
+			continue;
+		}
+		if (split(state)) {
+			state.pop();
+			continue;
+		}
+		branches.emplace_back(state, options);
+	}
+	return true;
+}
+
+// children of the node in the order of the dispatching rules: earliest start first, then earliest end
+void ordered_children(const SearchState& state, const DfsOptions& options, std::vector<int>& children) {
+	Branch branch(state, options);
+	children.clear();
+	for (int job = 0; job < state.jobs.size(); ++job)
+		if (branch.can_branch(state, job))
+			children.push_back(job);
+	auto start_end = [&](int job) {
+		auto& task = state.jobs[job][state.last_task_indices[job]];
+		int start_time = std::max(state.machine_times[task.machine], state.job_times[job]);
+		return std::pair{start_time, start_time + task.time};
+	};
+	std::sort(children.begin(), children.end(), [&](int a, int b) {
+		return start_end(a) < start_end(b);
+	});
+}
+
+// limited discrepancy search of the tree rooted at the current state: iteration k explores the nodes reached by
+// departing at most k times from the dispatching rule order, so the first iterations follow the rule closely and
+// find good schedules early. it is complete once an iteration didn't cut any child. returns false if the limits
+// stopped the search, the state is then back at the root
+bool _limited_discrepancy_search(SearchState& state, Incumbent& incumbent, const DfsOptions& options, DfsStats& stats) {
+	struct Frame {
+		std::vector<int> children;
+		int next_child = 0;
+		int discrepancies = 0; // left for the rest of the path
+	};
+	std::vector<Frame> frames(state.number_of_tasks - state.choices.size() + 1);
+
+	for (int limit = 0; ; ++limit) {
+		bool cut = false;
+		int depth = 0;
+		frames[0].next_child = 0;
+		frames[0].discrepancies = limit;
+		ordered_children(state, options, frames[0].children);
+
+		while (true) {
+			auto& frame = frames[depth];
+			if (frame.next_child == frame.children.size() or (frame.next_child > 0 and frame.discrepancies == 0)) {
+				cut |= frame.next_child < frame.children.size();
+				if (depth == 0)
+					break;
+				state.pop();
+				depth--;
+				continue;
+			}
+			int discrepancies = frame.discrepancies - (frame.next_child > 0);
+			state.push(frame.children[frame.next_child++]);
+			Visit visit = visit_node(state, incumbent, options, stats);
+			if (visit == Visit::stop) {
+				for (int d = 0; d <= depth; ++d)
+					state.pop();
+				return false;
+			}
+			if (visit == Visit::skip) {
+				state.pop();
+				continue;
+			}
+			depth++;
+			frames[depth].next_child = 0;
+			frames[depth].discrepancies = discrepancies;
+			ordered_children(state, options, frames[depth].children);
+		}
+		if (not cut)
+			return true;
+	}
+}
+
+// best first search of the tree rooted at the current state: the open node with the smallest lower bound is popped
+// and the search dives from it, always into the child with the smallest bound (the first in the dispatching rule
+// order among equal bounds), while the other children are added to the open nodes. the dives reach complete
+// schedules early, which a pure best first order only does at the very end. a node is its parent, the job of its
+// last task and its bound, and the state is moved to it through their common ancestor. once best_first_nodes nodes
+// are stored, the subtrees of the popped nodes are searched depth first. returns false if the limits stopped the
+// search, the state is then back at the root
+bool _best_first_search(SearchState& state, Incumbent& incumbent, const DfsOptions& options, DfsStats& stats) {
+	struct Node {
+		int parent;
+		int job;
+		int lower_bound;
+		int depth;
+	};
+	std::vector<Node> nodes;
+	nodes.reserve(std::min<size_t>(options.best_first_nodes, 1 << 16));
+	using Entry = std::tuple<int, int, int>; // lower bound, -depth, node
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+	int root_depth = state.choices.size();
+	nodes.push_back({-1, -1, state.lower_bound, 0});
+	open.emplace(state.lower_bound, 0, 0);
+
+	std::vector<int> path;
+	auto move_to = [&](int node) {
+		path.clear();
+		for (int n = node; nodes[n].parent != -1; n = nodes[n].parent)
+			path.push_back(nodes[n].job);
+		std::reverse(path.begin(), path.end());
+		int common = 0;
+		while (common < path.size() and root_depth + common < state.choices.size() and state.choices[root_depth + common] == path[common])
+			common++;
+		while (state.choices.size() > root_depth + common)
+			state.pop();
+		for (int i = common; i < path.size(); ++i)
+			state.push(path[i]);
+		state.lower_bound = std::max(state.lower_bound, nodes[node].lower_bound);
+	};
+	auto no_split = [](SearchState&) { return false; };
+	std::vector<int> children;
+
+	while (not open.empty()) {
+		auto [lower_bound, negative_depth, node] = open.top();
+		open.pop();
+		if (lower_bound >= incumbent.get()) {
+			stats.pruned[DfsStats::ancestor]++;
+			continue;
+		}
+		move_to(node);
+		if (nodes.size() >= options.best_first_nodes) {
+			if (not _dfs_optimized(state, incumbent, options, stats, no_split)) {
+				while (state.choices.size() > root_depth)
+					state.pop();
+				return false;
+			}
+			continue;
+		}
+		int current = node;
+		while (current != -1 and nodes.size() < options.best_first_nodes) {
+			ordered_children(state, options, children);
+			int best_child = -1;
+			for (int job : children) {
+				state.push(job);
+				Visit visit = visit_node(state, incumbent, options, stats);
+				if (visit == Visit::stop) {
+					while (state.choices.size() > root_depth)
+						state.pop();
+					return false;
+				}
+				if (visit == Visit::expand) {
+					nodes.push_back({current, job, state.lower_bound, nodes[current].depth + 1});
+					int child = nodes.size() - 1;
+					if (best_child == -1 or state.lower_bound < nodes[best_child].lower_bound)
+						std::swap(best_child, child);
+					if (child != -1)
+						open.emplace(nodes[child].lower_bound, -nodes[child].depth, child);
+				}
+				state.pop();
+			}
+			current = best_child;
+			if (current != -1) {
+				state.push(nodes[current].job);
+				state.lower_bound = std::max(state.lower_bound, nodes[current].lower_bound);
+			}
+		}
+		// the memory ran out during the dive
+		if (current != -1)
+			open.emplace(nodes[current].lower_bound, -nodes[current].depth, current);
+	}
+	while (state.choices.size() > root_depth)
+		state.pop();
+	return true;
+}
+
+// makes the initial schedule, or the upper bound if there is none, the incumbent and starts the limits
+void init_incumbent(const jssp::Jobs& jobs, int number_of_machines, DfsOptions& options, Incumbent& incumbent) {
+	if (options.limits != nullptr)
+		options.limits->start_limits();
+	incumbent.makespan = options.upper_bound;
+	if (not options.initial_schedule.empty()) {
+		std::vector<int> choices;
+		for (auto& task : options.initial_schedule)
+			choices.push_back(task.job);
+		// the search only reads the jobs of the schedule, so its tasks must be in job order
+		auto schedule = schedule_from_choices(jobs, choices);
+		int makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
+		incumbent.offer(makespan, choices);
+		if (options.shared_incumbent != nullptr)
+			options.shared_incumbent->offer(makespan, std::move(schedule));
+	}
+	incumbent.shared = options.shared_incumbent;
+}
+
+DfsResult make_result(const jssp::Jobs& jobs, const DfsOptions& options, Incumbent& incumbent, bool optimal, const DfsStats& stats) {
+	DfsResult result = {incumbent.makespan, schedule_from_choices(jobs, incumbent.choices), optimal, stats};
+	if (options.shared_incumbent == nullptr)
+		return result;
+	// the search also pruned with the shared makespan, so when the shared schedule is better the proof is about it
+	auto best = options.shared_incumbent->best();
+	if (best != nullptr and best->makespan < result.makespan) {
+		result.makespan = best->makespan;
+		result.schedule = best->schedule;
+	}
+	if (optimal and best != nullptr and best->makespan == result.makespan)
+		options.shared_incumbent->prove_optimal();
+	return result;
+}
+
+DfsResult dfs_optimized(const jssp::Jobs& jobs, int number_of_machines, DfsOptions options = {}) {
+	bool use_transposition_table = options.order != SearchOrder::limited_discrepancy;
+	SearchState state(jobs, number_of_machines, use_transposition_table ? options.transposition_table_size : 0);
+	state.set_subproblem(options);
+	Incumbent incumbent;
+	DfsStats stats;
+	init_incumbent(jobs, number_of_machines, options, incumbent);
+	bool optimal;
+	switch (options.order) {
+	case SearchOrder::limited_discrepancy:
+		optimal = _limited_discrepancy_search(state, incumbent, options, stats);
+		break;
+	case SearchOrder::best_first:
+		optimal = _best_first_search(state, incumbent, options, stats);
+		break;
+	default:
+		optimal = _dfs_optimized(state, incumbent, options, stats, [](SearchState&) { return false; });
+	}
+	return make_result(jobs, options, incumbent, optimal, stats);
+}
+
+// open subtree of the parallel search: the choices leading to its root, replayed from the root of the search
+struct Subtree {
+	std::vector<int> choices;
+};
+
+// subtrees owned by a worker: the owner takes the deepest from the back, thieves steal the shallowest from the front
+struct SubtreeDeque {
+	std::mutex mutex;
+	std::deque<Subtree> subtrees;
+
+	void push(Subtree subtree) {
+		std::lock_guard lock(mutex);
+		subtrees.push_back(std::move(subtree));
+	}
+	bool pop(Subtree& subtree) {
+		std::lock_guard lock(mutex);
+		if (subtrees.empty())
+			return false;
+		subtree = std::move(subtrees.back());
+		subtrees.pop_back();
+		return true;
+	}
+	bool steal(Subtree& subtree) {
+		std::lock_guard lock(mutex);
+		if (subtrees.empty())
+			return false;
+		subtree = std::move(subtrees.front());
+		subtrees.pop_front();
+		return true;
+	}
+	bool empty() {
+		std::lock_guard lock(mutex);
+		return subtrees.empty();
+	}
+};
+
+// parallel branch and bound: every worker runs the depth first search on the subtrees of its deque. while some
+// worker is idle, the busy ones hand the nodes they would descend into to their deque instead, where the idle
+// workers steal them from, sleeping until a subtree is pushed. the search ends when no subtree is left open
+DfsResult dfs_optimized_parallel(const jssp::Jobs& jobs, int number_of_machines, int number_of_threads, DfsOptions options = {}) {
+	int workers = std::max(1, number_of_threads);
+	std::vector<SubtreeDeque> deques(workers);
+	std::vector<DfsStats> stats(workers);
+	Incumbent incumbent;
+	// subtrees pushed and not fully explored yet, a subtree is closed only after the ones split from it were pushed
+	std::atomic<long> open_subtrees = 1;
+	std::atomic<int> idle_workers = 0;
+	std::atomic<bool> stopped = false;
+	// the idle workers wait on idle_condition until wake_ups changes: a subtree was pushed or the search ended
+	std::mutex idle_mutex;
+	std::condition_variable idle_condition;
+	long wake_ups = 0; // guarded by idle_mutex
+	auto wake_idle_workers = [&](bool all) {
+		{
+			std::lock_guard lock(idle_mutex);
+			wake_ups++;
+		}
+		if (all)
+			idle_condition.notify_all();
+		else
+			idle_condition.notify_one();
+	};
+
+	init_incumbent(jobs, number_of_machines, options, incumbent);
+	deques[0].push({});
+
+	auto work = [&](int worker) {
+		SearchState state(jobs, number_of_machines, options.transposition_table_size);
+		state.set_subproblem(options);
+		auto split = [&](SearchState& state) {
+			if (idle_workers.load(std::memory_order_relaxed) == 0 or
+				state.number_of_tasks - state.choices.size() < options.min_split_tasks or not deques[worker].empty())
+				return false;
+			open_subtrees++;
+			deques[worker].push({state.choices});
+			wake_idle_workers(false);
+			return true;
+		};
+
+		Subtree subtree;
+		bool idle = false;
+		while (open_subtrees.load() > 0 and not stopped) {
+			// read before looking at the deques so that a subtree pushed after they were found empty still wakes it
+			long seen_wake_ups;
+			{
+				std::lock_guard lock(idle_mutex);
+				seen_wake_ups = wake_ups;
+			}
+			bool found = deques[worker].pop(subtree);
+			for (int i = 1; i < workers and not found; ++i)
+				found = deques[(worker + i) % workers].steal(subtree);
+			if (not found) {
+				if (not idle)
+					idle_workers++;
+				idle = true;
+				std::unique_lock lock(idle_mutex);
+				idle_condition.wait(lock, [&] { return wake_ups != seen_wake_ups or open_subtrees.load() == 0 or stopped; });
+				continue;
+			}
+			if (idle)
+				idle_workers--;
+			idle = false;
+
+			// move the state from the root to the root of the subtree
+			while (not state.choices.empty())
+				state.pop();
+			for (int job : subtree.choices)
+				state.push(job);
+			if (not _dfs_optimized(state, incumbent, options, stats[worker], split)) {
+				stopped = true;
+				wake_idle_workers(true);
+			}
+			if (--open_subtrees == 0)
+				wake_idle_workers(true);
+		}
+	};
+
+	std::vector<std::thread> thread_pool;
+	for (int worker = 0; worker < workers; ++worker)
+		thread_pool.emplace_back(work, worker);
+	for (auto& thread : thread_pool)
+		thread.join();
+
+	DfsStats total;
+	for (auto& worker_stats : stats)
+		total += worker_stats;
+	return make_result(jobs, options, incumbent, not stopped, total);
+}
+
@@ -0,0 +1,284 @@
+#pragma once
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <limits>
+#include <cmath>
+#include <ranges>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "pso2.cpp"
+
+namespace brkga {
+
+	struct Individual {
+		std::vector<float> keys; // one per task, at job * number_of_machines + index like the positions of pso::Particle
+		int makespan = std::numeric_limits<int>::max();
+	};
+
+	// individuals sorted by makespan, the elite partition first. the next generation is built in next and the two are
+	// swapped, so once every chromosome has its size a generation doesn't allocate
+	struct Population {
+		std::vector<Individual> individuals;
+		std::vector<Individual> next;
+	};
+
+	// biased random-key genetic algorithm (goncalves and resende) on the random-key decoder of pso2.cpp. every
+	// generation keeps the elite partition of a population, replaces its mutant partition with random chromosomes and
+	// fills the rest with crossovers of a random elite and a random non-elite parent, every key coming from the elite
+	// one with probability elite_inheritance. the chromosomes of a generation, of all the populations, are split in
+	// contiguous slices between workers that build and decode them. the populations evolve independently, except that
+	// every exchange_interval generations the exchange_count best individuals of each replace the worst of the others
+	struct Brkga : util::SearchLimits {
+
+		const jssp::Jobs& jobs;
+		int number_of_machines;
+		int number_of_tasks;
+
+		int generations = 1000;
+		int population_size = 100;
+		float elite_fraction = 0.2f;
+		float mutant_fraction = 0.15f;
+		float elite_inheritance = 0.7f; // probability that a key of a crossover comes from the elite parent
+		float delta = 0.5f; // see pso::decode
+		int number_of_populations = 1;
+		int exchange_interval = 50; // 0 disables the exchanges
+		int exchange_count = 2;
+		int number_of_threads = 0; // 0 means one per hardware thread
+
+		std::vector<Population> populations;
+		int generation = 0; // generations of the last run, the first one evaluates the random initial populations
+		long exchanges = 0;
+
+		std::vector<float> best_keys;
+		int best_makespan = std::numeric_limits<int>::max();
+		// guards best_keys and best_makespan so the best solution can be read while a run is in progress
+		std::mutex best_mutex;
+
+		// makespans of already decoded priority orders, disabled until set_cache_size is called
+		pso::FitnessCache cache;
+		std::mt19937 random_engine;
+
+		Brkga(const jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines),
+			number_of_tasks(jobs.size() * number_of_machines), random_engine(std::random_device()()) {}
+
+		void set_generations(int generations) {
+			this->generations = generations;
+		}
+		void set_population_size(int population_size) {
+			this->population_size = std::max(2, population_size);
+		}
+		void set_elite_fraction(float elite_fraction) {
+			this->elite_fraction = std::clamp(elite_fraction, 0.f, 1.f);
+		}
+		void set_mutant_fraction(float mutant_fraction) {
+			this->mutant_fraction = std::clamp(mutant_fraction, 0.f, 1.f);
+		}
+		void set_elite_inheritance(float elite_inheritance) {
+			this->elite_inheritance = std::clamp(elite_inheritance, 0.f, 1.f);
+		}
+		void set_delta(float delta) {
+			this->delta = std::clamp(delta, 0.f, 1.f);
+			// cached makespans were decoded with the previous delta
+			cache.clear();
+		}
+		void set_number_of_populations(int number_of_populations) {
+			this->number_of_populations = std::max(1, number_of_populations);
+		}
+		void set_exchange(int exchange_interval, int exchange_count) {
+			this->exchange_interval = exchange_interval;
+			this->exchange_count = exchange_count;
+		}
+		void set_number_of_threads(int number_of_threads) {
+			this->number_of_threads = number_of_threads;
+		}
+		void set_cache_size(size_t size) {
+			cache.resize(size);
+		}
+		void set_seed(unsigned seed) {
+			random_engine.seed(seed);
+		}
+
+		// at least one elite and one individual that is neither elite nor mutant, the crossovers need both parents
+		int number_of_elites() const {
+			return std::clamp<int>(std::round(elite_fraction * population_size), 1, population_size - 1);
+		}
+		int number_of_mutants() const {
+			return std::clamp<int>(std::round(mutant_fraction * population_size), 0, population_size - number_of_elites() - 1);
+		}
+		int number_of_workers() const {
+			int workers = number_of_threads > 0 ? number_of_threads : std::thread::hardware_concurrency();
+			return std::clamp(workers, 1, number_of_populations * population_size);
+		}
+
+		int fitness(const std::vector<float>& keys, pso::Decoder& decoder) {
+			count_evaluation();
+			return pso::evaluate_keys(jobs, number_of_machines, delta, keys, decoder, cache);
+		}
+
+		void init_populations() {
+			populations.assign(number_of_populations, {});
+			for (auto& population : populations) {
+				population.individuals.assign(population_size, {std::vector<float>(number_of_tasks), std::numeric_limits<int>::max()});
+				population.next = population.individuals;
+			}
+		}
+
+		// builds the individual at index i of the next generation of the population from the current one and decodes it.
+		// the first generation is made of random chromosomes only
+		void build_individual(Population& population, int i, bool initial, std::mt19937& engine, pso::Decoder& decoder) {
+			auto& child = population.next[i];
+			int elites = number_of_elites();
+			std::uniform_real_distribution<float> random_key(0.f, 1.f);
+			if (not initial and i < elites) {
+				child.keys = population.individuals[i].keys;
+				child.makespan = population.individuals[i].makespan;
+				return;
+			}
+			if (initial or i >= population_size - number_of_mutants()) {
+				for (auto& key : child.keys)
+					key = random_key(engine);
+			} else {
+				auto& elite = population.individuals[std::uniform_int_distribution(0, elites - 1)(engine)];
+				auto& other = population.individuals[std::uniform_int_distribution(elites, population_size - 1)(engine)];
+				for (int k = 0; k < number_of_tasks; ++k)
+					child.keys[k] = random_key(engine) < elite_inheritance ? elite.keys[k] : other.keys[k];
+			}
+			child.makespan = fitness(child.keys, decoder);
+		}
+
+		// the exchange_count best individuals of every population replace the worst ones of every other population,
+		// never more than its non-elite individuals
+		void exchange_elites() {
+			int count = std::clamp(exchange_count, 0, population_size);
+			if (number_of_populations < 2 or count == 0)
+				return;
+			std::vector<Individual> migrants;
+			for (auto& population : populations)
+				migrants.insert(migrants.end(), population.individuals.begin(), population.individuals.begin() + count);
+			int replaced_max = population_size - number_of_elites();
+			for (int p = 0; p < populations.size(); ++p) {
+				auto& individuals = populations[p].individuals;
+				int replaced = 0;
+				for (int i = 0; i < migrants.size() and replaced < replaced_max; ++i) {
+					if (i / count == p)
+						continue;
+					auto& worst = individuals[population_size - 1 - replaced++];
+					worst.keys = migrants[i].keys;
+					worst.makespan = migrants[i].makespan;
+				}
+				std::stable_sort(individuals.begin(), individuals.end(), [](const Individual& a, const Individual& b) {
+					return a.makespan < b.makespan;
+				});
+			}
+			exchanges++;
+		}
+
+		void update_best() {
+			int improvement = std::numeric_limits<int>::max();
+			for (auto& population : populations) {
+				auto& best = population.individuals.front();
+				if (best.makespan < best_makespan) {
+					std::lock_guard lock(best_mutex);
+					best_keys = best.keys;
+					best_makespan = best.makespan;
+					improvement = best_makespan;
+				}
+			}
+			// outside the lock, the callback may read the best schedule
+			if (improvement < std::numeric_limits<int>::max())
+				report_improvement(improvement);
+		}
+
+		// evolves the populations, from random ones on the first run and from where the last run stopped on the next
+		// ones, and returns the best schedule. best_makespan holds its makespan
+		jssp::Schedule run() {
+			bool initial = populations.empty();
+			if (initial)
+				init_populations();
+			int workers = number_of_workers();
+			int slots = number_of_populations * population_size;
+			std::vector<util::ThreadSleeper> threads(workers);
+			std::vector<std::thread> thread_pool;
+			util::ThreadSleeper main_thread;
+
+			int left_threads = workers;
+			std::mutex left_mutex;
+			bool stop = false;
+
+			for (int t = 0; t < workers; t++) {
+				int begin = t * slots / workers, end = (t + 1) * slots / workers;
+				thread_pool.emplace_back([&, t, begin, end, seed = random_engine()] {
+					pso::Decoder decoder;
+					std::mt19937 engine(seed);
+					while (true) {
+						threads[t].sleep_forever();
+						if (stop)
+							return;
+						// once a budget is spent the rest of the slice is left undecoded, worst of all
+						for (int slot = begin; slot < end; ++slot) {
+							auto& population = populations[slot / population_size];
+							if (should_stop())
+								population.next[slot % population_size].makespan = std::numeric_limits<int>::max();
+							else
+								build_individual(population, slot % population_size, initial, engine, decoder);
+						}
+						std::lock_guard lock(left_mutex);
+						left_threads--;
+						if (left_threads == 0)
+							main_thread.wake_thread();
+					}
+				});
+			}
+
+			start_limits();
+			for (generation = 0; generation < generations and not should_stop(); ++generation) {
+				for (auto& thread : threads)
+					thread.wake_thread();
+				main_thread.sleep_forever();
+				left_threads = workers;
+				initial = false;
+				// the workers are all asleep here so the populations can be modified without locking
+				for (auto& population : populations) {
+					std::swap(population.individuals, population.next);
+					std::stable_sort(population.individuals.begin(), population.individuals.end(), [](const Individual& a, const Individual& b) {
+						return a.makespan < b.makespan;
+					});
+				}
+				if (exchange_interval > 0 and (generation + 1) % exchange_interval == 0)
+					exchange_elites();
+				update_best();
+			}
+			stop = true;
+			for (auto [thread_sleeper, thread] : std::ranges::views::zip(threads, thread_pool)) {
+				thread_sleeper.wake_thread();
+				thread.join();
+			}
+			return get_best_schedule();
+		}
+
+		int get_best_makespan() {
+			std::lock_guard lock(best_mutex);
+			return best_makespan;
+		}
+
+		// safe to call from another thread while run is in progress
+		jssp::Schedule get_best_schedule() {
+			std::vector<float> keys;
+			{
+				std::lock_guard lock(best_mutex);
+				keys = best_keys;
+			}
+			if (keys.empty())
+				return {};
+			pso::Decoder decoder;
+			pso::rank_keys(keys, decoder);
+			pso::decode(jobs, number_of_machines, delta, decoder);
+			jssp::sort_schedule(decoder.schedule, jobs.size(), number_of_machines);
+			return decoder.schedule;
+		}
+	};
+
+}
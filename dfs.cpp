@@ -1,92 +1,61 @@
 #include <vector>
-#include <list>
-#include <algorithm>
-#include <ranges>
-#include <random>
 #include <fstream>
 
 #include "parse.cpp"
 #include "util.cpp"
 #include "jssp.cpp"
+#include "bnb.cpp"
+#include "dp.cpp"
 
+// runs the search on the first instance of the benchmark for 30 minutes, starting from the shortest starting time rule
+void benchmark_dfs_optimized(int j, int m) {
+	std::string filename = "experiments/results/dfs-optimized-benchmark.csv";
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+
+	util::SearchLimits limits;
+	limits.set_time_limit(util::minutes(30));
+	limits.set_on_improvement([](int makespan, long nodes, util::milliseconds time) {
+		util::println("makespan {} after {} nodes, {} ms", makespan, nodes, time.count());
+	});
+	DfsOptions options;
+	options.limits = &limits;
+	options.initial_schedule = jssp::generate_schedule_shortest_starting_time(jobs, m);
+	auto result = dfs_optimized(jobs, m, options);
+	util::write(filename, util::format("{} {},{},{},\n", j, m, result.makespan, result.optimal ? "optimal" : "30min"), std::ios::app);
+}
 
-
-/* dfs optimized
-- store the last task index of each job in a vector initialized to 0
-- create an empty schedule
-- call dfs with the initial schedule and the last task index vector
-- in the dfs function:
-  - if the schedule is full, evaluate it and update the best schedule if necessary
-  - else
-	- for each job
-	- get the last task index of the job
-	- get the task at that index
-	- add the task to the schedule
-	- increment the last task index of the job
-	- evaluate the schedule
-	- if the schedule is worse than the best schedule, remove the task from the schedule and decrement the last task index of the job and continue
-	- call dfs with the new schedule and the new last task index of the job
-	*/
-
-
-/*
-util::minutes max_time(30);
-util::stopwatch sw;
-std::string filename = util::format("experiments/results/dfs-optimized-benchmark.csv");
-auto write = [](int j, int m, int makespan, auto time) {
-	util::write(filename, util::format("{},{},{},\n", util::format("{} {}", j, m), makespan, time), std::ios::app);
-};
-
-
-void _dfs_optimized(const jssp::Jobs& jobs, jssp::Schedule& schedule, int number_of_machines, int& best_makespan, jssp::Schedule& best_schedule, std::vector<int>& last_task_indices) {
-	if (schedule.size() == jobs.size() * number_of_machines) {
-		int current_makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
-		if (current_makespan < best_makespan) {
-			best_makespan = current_makespan;
-			best_schedule = schedule;
-		}
-		if (sw.elapsed<util::minutes>() > max_time) {
-			// write(jobs.size(), number_of_machines, best_makespan, sw.elapsed<util::minutes>());
-			util::println("Best makespan: {}", best_makespan);
-			std::exit(0);
-		}
-		return;
-	}
-
-	for (int job = 0; job < jobs.size(); ++job) {
-		if (sw.elapsed<util::minutes>() > max_time) {
-			// write(jobs.size(), number_of_machines, best_makespan, sw.elapsed<util::minutes>());
-			util::println("Best makespan: {}", best_makespan);
-			std::exit(0);
-		}
-		if (last_task_indices[job] < jobs[job].size()) {
-			auto task = jobs[job][last_task_indices[job]];
-			schedule.push_back(task);
-			last_task_indices[job]++;
-			int current_makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
-			if (current_makespan < best_makespan) {
-				_dfs_optimized(jobs, schedule, number_of_machines, best_makespan, best_schedule, last_task_indices);
-			}
-			schedule.pop_back();
-			last_task_indices[job]--;
+// best makespan of each search order after 10 ms, 100 ms, 1 s and 10 s on the first instance of the benchmark
+void benchmark_search_orders(int j, int m) {
+	std::string filename = "experiments/results/search-orders-benchmark.csv";
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	std::vector<std::pair<SearchOrder, std::string>> orders = {
+		{SearchOrder::depth_first, "depth first"}, {SearchOrder::limited_discrepancy, "limited discrepancy"}, {SearchOrder::best_first, "best first"}};
+	std::vector<util::milliseconds> checkpoints = {util::milliseconds(10), util::milliseconds(100), util::seconds(1), util::seconds(10)};
+
+	for (auto& [order, name] : orders) {
+		std::vector<std::pair<util::milliseconds, int>> improvements;
+		util::SearchLimits limits;
+		limits.set_time_limit(checkpoints.back());
+		limits.set_on_improvement([&](int makespan, long, util::milliseconds time) {
+			improvements.push_back({time, makespan});
+		});
+		DfsOptions options;
+		options.order = order;
+		options.limits = &limits;
+		dfs_optimized(jobs, m, options);
+
+		std::string line = util::format("{} {},{}", j, m, name);
+		for (auto checkpoint : checkpoints) {
+			int best = -1;
+			for (auto& [time, makespan] : improvements)
+				if (time <= checkpoint)
+					best = makespan;
+			line += util::format(",{}", best);
 		}
+		line += "\n";
+		util::print(line);
+		util::write(filename, line, std::ios::app);
 	}
-
-}
-
-int dfs_optimized(const jssp::Jobs& jobs, int number_of_machines) {
-	jssp::Schedule best_schedule, current_schedule;
-	int best_makespan = std::numeric_limits<int>::max();
-	std::vector<int> last_task_indices(jobs.size(), 0);
-	_dfs_optimized(jobs, current_schedule, number_of_machines, best_makespan, best_schedule, last_task_indices);
-	util::println("Best makespan: {}", best_makespan);
-	jssp::print_schedule(best_schedule);
-	return best_makespan;
-}
-
-void benchmark_dfs_optimized(int j, int m) {
-	// util::write(filename, "jobs machines,makespan,time,\n", std::ios::out | std::ios::trunc);
-	dfs_optimized(load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0], m);
 }
 
 void benchmark_dfs() {
@@ -103,51 +72,39 @@ void benchmark_dfs() {
 		for (int m = 2; m <= max_machines; m++) {
 			jssp::Jobs jobs = jssp::generate_random_jobs(j, m);
 			sw.init();
-			int makespan = dfs_optimized(jobs, m);
+			int makespan = dfs_optimized(jobs, m).makespan;
 			int time = sw.elapsed<util::microseconds>().count();
 			write(j, m, makespan, time);
 		}
 	}
 }
 
-*/
-
-
-
-void _dfs_optimized(const jssp::Jobs& jobs, jssp::Schedule& schedule, int number_of_machines, int& best_makespan, jssp::Schedule& best_schedule, std::vector<int>& last_task_indices) {
-	if (schedule.size() == jobs.size() * number_of_machines) {
-		int current_makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
-		if (current_makespan < best_makespan) {
-			best_makespan = current_makespan;
-			best_schedule = schedule;
-		}
-		return;
-	}
-
-	for (int job = 0; job < jobs.size(); ++job) {
-		if (last_task_indices[job] < jobs[job].size()) {
-			auto task = jobs[job][last_task_indices[job]];
-			schedule.push_back(task);
-			last_task_indices[job]++;
-			int current_makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
-			if (current_makespan < best_makespan) {
-				_dfs_optimized(jobs, schedule, number_of_machines, best_makespan, best_schedule, last_task_indices);
+// times the dynamic program and the depth first search on the same random instances, 10 per size, and checks that
+// they agree, in experiments/results/dp-vs-dfs.csv
+void benchmark_dp() {
+	std::string filename = "experiments/results/dp-vs-dfs.csv";
+	util::write(filename, "jobs,machines,makespan,dp time us,dfs time us,dp states,dp memory bytes\n", std::ios::out | std::ios::trunc);
+	int max_jobs = 6;
+	int max_machines = 6;
+	int instances = 10;
+	util::stopwatch sw;
+	for (int j = 2; j <= max_jobs; j++) {
+		for (int m = 2; m <= max_machines; m++) {
+			for (int i = 0; i < instances; i++) {
+				jssp::Jobs jobs = jssp::generate_random_jobs(j, m);
+				sw.init();
+				auto dp_result = dp::dp_optimal(jobs, m);
+				int dp_time = sw.elapsed<util::microseconds>().count();
+				sw.init();
+				int makespan = dfs_optimized(jobs, m).makespan;
+				int dfs_time = sw.elapsed<util::microseconds>().count();
+				if (makespan != dp_result.makespan)
+					util::println("{}x{}: the dynamic program found {}, the search {}", j, m, dp_result.makespan, makespan);
+				util::write(filename, util::format("{},{},{},{},{},{},{}\n", j, m, makespan, dp_time, dfs_time,
+					dp_result.stats.states, dp_result.stats.memory), std::ios::app);
 			}
-			schedule.pop_back();
-			last_task_indices[job]--;
 		}
 	}
-
-}
-
-int dfs_optimized(const jssp::Jobs& jobs, int number_of_machines) {
-	jssp::Schedule best_schedule, current_schedule;
-	int best_makespan = std::numeric_limits<int>::max();
-	std::vector<int> last_task_indices(jobs.size(), 0);
-	_dfs_optimized(jobs, current_schedule, number_of_machines, best_makespan, best_schedule, last_task_indices);
-	util::println("Best makespan: {}", best_makespan);
-	jssp::print_schedule(best_schedule);
-	return best_makespan;
 }
 
 void test_dfs() {
@@ -155,7 +112,10 @@ void test_dfs() {
 	int m = 4;
 	jssp::Jobs jobs = jssp::generate_random_jobs(j, m);
 	jssp::print_jobs(jobs);
-	dfs_optimized(jobs, m);
+	auto result = dfs_optimized(jobs, m);
+	util::println("Best makespan: {}", result.makespan);
+	jssp::print_schedule(result.schedule);
+	result.stats.print();
 }
 
 
@@ -0,0 +1,269 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <bit>
+#include <queue>
+#include <tuple>
+#include "util.cpp"
+#include "jssp.cpp"
+
+namespace dp {
+
+	struct DpStats {
+		long states = 0; // states expanded
+		long dominated = 0; // children dropped because a state with the same progress was at least as good
+		long replaced = 0; // states dropped because a child with the same progress was better
+		long pruned = 0; // children whose lower bound reached the upper bound
+		size_t memory = 0; // bytes held by the state table and the open states
+
+		void print() const {
+			util::println("States: {}, dominated: {}, replaced: {}, pruned: {}, memory: {} KiB", states, dominated, replaced, pruned, memory / 1024);
+		}
+	};
+
+	struct DpResult {
+		int makespan;
+		jssp::Schedule schedule;
+		DpStats stats;
+	};
+
+	// every state reached so far, in an arena of flat buffers. the states that have the same progress (next task index
+	// of every job, packed in a key) are chained from a slot of an open addressing table, and only the ones whose machine
+	// and job times are not dominated by another state of the chain are alive
+	struct StateTable {
+		int stride;
+		std::vector<uint64_t> keys;
+		std::vector<int> profiles; // machine times then job times of every state
+		std::vector<int> lower_bounds;
+		std::vector<int> next; // next alive state of the chain, -1 at the end
+		std::vector<char> alive;
+		// the state it was expanded from and the job of its last task, to rebuild the schedule
+		std::vector<int> parents;
+		std::vector<int> choices;
+
+		std::vector<uint64_t> slot_keys;
+		std::vector<int> slot_heads; // first state of the chain of the slot, -1 if empty
+		int used_slots = 0;
+
+		StateTable(int stride) : stride(stride), slot_keys(1024), slot_heads(1024, -1) {}
+
+		int size() const {
+			return keys.size();
+		}
+		int* profile(int state) {
+			return profiles.data() + state * stride;
+		}
+
+		// slot of the key, or the empty slot where it goes
+		size_t find_slot(uint64_t key) const {
+			size_t mask = slot_heads.size() - 1;
+			size_t slot = (key * 0x9e3779b97f4a7c15ull) >> 32 & mask;
+			while (slot_heads[slot] != -1 and slot_keys[slot] != key)
+				slot = (slot + 1) & mask;
+			return slot;
+		}
+		void grow() {
+			std::vector<uint64_t> old_keys = std::move(slot_keys);
+			std::vector<int> old_heads = std::move(slot_heads);
+			slot_keys.assign(old_keys.size() * 2, 0);
+			slot_heads.assign(old_heads.size() * 2, -1);
+			for (size_t slot = 0; slot < old_heads.size(); ++slot) {
+				if (old_heads[slot] == -1)
+					continue;
+				size_t new_slot = find_slot(old_keys[slot]);
+				slot_keys[new_slot] = old_keys[slot];
+				slot_heads[new_slot] = old_heads[slot];
+			}
+		}
+
+		// adds the state unless a state with the same key dominates it, and kills the states it dominates. returns
+		// the new state or -1
+		int insert(uint64_t key, const int* new_profile, int lower_bound, int parent, int choice, DpStats& stats) {
+			if (2 * (used_slots + 1) > slot_heads.size())
+				grow();
+			size_t slot = find_slot(key);
+			if (slot_heads[slot] == -1) {
+				slot_keys[slot] = key;
+				used_slots++;
+			}
+			// the killed states are unlinked on the way so that the chains only hold the pareto front
+			for (int* link = &slot_heads[slot]; *link != -1;) {
+				int state = *link;
+				int* existing = profile(state);
+				bool existing_better = true;
+				bool new_better = true;
+				for (int i = 0; i < stride; ++i) {
+					existing_better &= existing[i] <= new_profile[i];
+					new_better &= new_profile[i] <= existing[i];
+				}
+				if (existing_better) {
+					stats.dominated++;
+					return -1;
+				}
+				if (new_better) {
+					alive[state] = false;
+					stats.replaced++;
+					*link = next[state];
+				} else {
+					link = &next[state];
+				}
+			}
+			keys.push_back(key);
+			profiles.insert(profiles.end(), new_profile, new_profile + stride);
+			lower_bounds.push_back(lower_bound);
+			next.push_back(slot_heads[slot]);
+			alive.push_back(true);
+			parents.push_back(parent);
+			choices.push_back(choice);
+			slot_heads[slot] = size() - 1;
+			return size() - 1;
+		}
+
+		size_t memory() const {
+			return keys.capacity() * sizeof(uint64_t) + profiles.capacity() * sizeof(int) + lower_bounds.capacity() * sizeof(int) +
+				next.capacity() * sizeof(int) + alive.capacity() + parents.capacity() * sizeof(int) + choices.capacity() * sizeof(int) +
+				slot_keys.capacity() * sizeof(uint64_t) + slot_heads.capacity() * sizeof(int);
+		}
+	};
+
+	// exact solver for tiny instances: a dynamic program over the states of the partial schedules, memoized by progress
+	// and non-dominated time profile, so the permutations that reach the same state are expanded once. a state only
+	// branches on its giffler-thompson conflict set, and the states are expanded by increasing lower bound, so the first
+	// complete one is optimal and no state with a lower bound above the optimum is expanded. children whose bound
+	// reaches upper_bound are not stored, when nothing is better the result has that makespan and no schedule. the
+	// progress key packs bit_width(number_of_machines) bits per job, which must fit in 64, and the instance can have
+	// at most 255 tasks
+	DpResult dp_optimal(const jssp::Jobs& jobs, int number_of_machines, int upper_bound = std::numeric_limits<int>::max()) {
+		int number_of_jobs = jobs.size();
+		int number_of_tasks = number_of_jobs * number_of_machines;
+		int bits = std::bit_width(unsigned(number_of_machines));
+		if (number_of_jobs * bits > 64 or number_of_tasks > 255) {
+			util::println("dp_optimal: the instance is too large");
+			return {std::numeric_limits<int>::max(), {}, {}};
+		}
+		uint64_t index_mask = (uint64_t(1) << bits) - 1;
+
+		// processing time of the job from the task index on, and index of the task of the job on each machine
+		std::vector<std::vector<int>> remaining_work(number_of_jobs);
+		std::vector<std::vector<int>> machine_task_indices(number_of_jobs, std::vector<int>(number_of_machines, -1));
+		for (int job = 0; job < number_of_jobs; ++job) {
+			remaining_work[job].assign(jobs[job].size() + 1, 0);
+			for (int index = jobs[job].size() - 1; index >= 0; --index) {
+				remaining_work[job][index] = remaining_work[job][index + 1] + jobs[job][index].time;
+				machine_task_indices[job][jobs[job][index].machine] = index;
+			}
+		}
+
+		// the tasks left on the machine can't start before it is free nor before the earliest of their heads, and the
+		// last one is followed by at least the smallest of their tails
+		auto machine_bound = [&](const int* profile, const std::vector<int>& task_indices, int machine) {
+			int min_head = std::numeric_limits<int>::max();
+			int min_tail = std::numeric_limits<int>::max();
+			int load = 0;
+			for (int job = 0; job < number_of_jobs; ++job) {
+				int index = machine_task_indices[job][machine];
+				int next = task_indices[job];
+				if (index < next)
+					continue;
+				min_head = std::min(min_head, profile[number_of_machines + job] + remaining_work[job][next] - remaining_work[job][index]);
+				min_tail = std::min(min_tail, remaining_work[job][index + 1]);
+				load += jobs[job][index].time;
+			}
+			if (load == 0)
+				return profile[machine];
+			return std::max(profile[machine], min_head) + load + min_tail;
+		};
+
+		DpResult result = {upper_bound, {}, {}};
+
+		int stride = number_of_machines + number_of_jobs;
+		StateTable table(stride);
+		// open states by lower bound, the deepest first among equal bounds so that complete states come out early. an
+		// entry packs the lower bound, the number of tasks left and the state in 24, 8 and 32 bits
+		auto entry = [&](int lower_bound, int depth, int state) {
+			return (uint64_t(lower_bound) << 40) | (uint64_t(number_of_tasks - depth) << 32) | uint32_t(state);
+		};
+		std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> open;
+		std::vector<int> root(stride, 0);
+		open.push(entry(0, 0, table.insert(0, root.data(), 0, -1, -1, result.stats)));
+
+		std::vector<int> task_indices(number_of_jobs);
+		std::vector<int> child(stride);
+		int best = -1;
+		while (not open.empty()) {
+			int lower_bound = open.top() >> 40;
+			int depth = number_of_tasks - int((open.top() >> 32) & 0xff);
+			int state = uint32_t(open.top());
+			open.pop();
+			if (not table.alive[state])
+				continue;
+			if (depth == number_of_tasks) {
+				// every open state has a bound at least as large, its lower bound is its makespan
+				best = state;
+				break;
+			}
+			result.stats.states++;
+			uint64_t key = table.keys[state];
+			for (int job = 0; job < number_of_jobs; ++job)
+				task_indices[job] = (key >> (job * bits)) & index_mask;
+
+			// giffler-thompson: the critical machine is the one of the next task with the earliest completion
+			int critical_machine = -1;
+			int completion = std::numeric_limits<int>::max();
+			for (int job = 0; job < number_of_jobs; ++job) {
+				if (task_indices[job] == jobs[job].size())
+					continue;
+				auto& task = jobs[job][task_indices[job]];
+				int* machine_times = table.profile(state);
+				int end_time = std::max(machine_times[task.machine], machine_times[number_of_machines + job]) + task.time;
+				if (end_time < completion) {
+					completion = end_time;
+					critical_machine = task.machine;
+				}
+			}
+
+			for (int job = 0; job < number_of_jobs; ++job) {
+				int index = task_indices[job];
+				if (index == jobs[job].size() or jobs[job][index].machine != critical_machine)
+					continue;
+				auto& task = jobs[job][index];
+				// the table may grow while the children are inserted
+				std::copy_n(table.profile(state), stride, child.data());
+				int start_time = std::max(child[task.machine], child[number_of_machines + job]);
+				if (start_time >= completion)
+					continue;
+				int end_time = start_time + task.time;
+				child[task.machine] = end_time;
+				child[number_of_machines + job] = end_time;
+				task_indices[job]++;
+				int child_bound = std::max({lower_bound, end_time + remaining_work[job][index + 1],
+					machine_bound(child.data(), task_indices, task.machine)});
+				task_indices[job]--;
+				if (child_bound >= result.makespan) {
+					result.stats.pruned++;
+					continue;
+				}
+				int child_state = table.insert(key + (uint64_t(1) << (job * bits)), child.data(), child_bound, state, job, result.stats);
+				if (child_state != -1)
+					open.push(entry(child_bound, depth + 1, child_state));
+			}
+		}
+		result.stats.memory = table.memory() + open.size() * sizeof(uint64_t);
+		if (best == -1)
+			return result;
+
+		result.makespan = table.lower_bounds[best];
+		std::vector<int> choices;
+		for (int state = best; table.parents[state] != -1; state = table.parents[state])
+			choices.push_back(table.choices[state]);
+		std::reverse(choices.begin(), choices.end());
+		result.schedule.clear();
+		std::vector<int> next_indices(number_of_jobs, 0);
+		for (int job : choices)
+			result.schedule.push_back(jobs[job][next_indices[job]++]);
+		return result;
+	}
+
+}
@@ -0,0 +1,393 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include "util.cpp"
+#include "jssp.cpp"
+
+namespace graph {
+
+	// longest path through the graph, and its blocks: the maximal runs of consecutive operations of the path on the
+	// same machine, as [begin, end) ranges of positions in the path
+	struct CriticalPath {
+		std::vector<int> operations;
+		std::vector<std::pair<int, int>> blocks;
+	};
+
+	// disjunctive graph of a schedule: every task is an operation, with arcs to the next operation of its job and to
+	// the next operation on its machine. the head of an operation is the longest path to its start, which is its start
+	// time in the semi-active schedule, and the tail is the longest path from its end. the graph keeps a topological
+	// order of the operations: a move only re-sorts the positions between the ends of the arcs it reversed, and then
+	// propagates the heads and tails in that order from the operations whose arcs changed, as long as they change
+	struct DisjunctiveGraph {
+
+		const jssp::Jobs& jobs;
+		int number_of_machines;
+		int number_of_operations;
+
+		// static data of the operations, numbered job after job
+		std::vector<int> job_offsets; // first operation of every job
+		std::vector<int> times;
+		std::vector<int> machines;
+		std::vector<int> job_prev; // -1 for the first operation of the job
+		std::vector<int> job_next; // -1 for the last one
+
+		// machine sequences as doubly linked lists
+		std::vector<int> machine_first;
+		std::vector<int> machine_prev;
+		std::vector<int> machine_next;
+
+		std::vector<int> order; // operations in topological order
+		std::vector<int> positions; // position of every operation in order
+
+		std::vector<int> heads;
+		std::vector<int> tails;
+		int makespan = 0;
+
+		// scratch of the updates: marks are stamps so that they never have to be cleared
+		std::vector<int> marks;
+		int stamp = 0;
+		std::vector<int> counts;
+		std::vector<int> window;
+		std::vector<int> ready;
+		std::vector<int> queue; // heap of positions
+		std::vector<int> old_run;
+		std::vector<int> seeds;
+
+		DisjunctiveGraph(const jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines),
+			number_of_operations(0), job_offsets(jobs.size()), machine_first(number_of_machines, -1) {
+			for (int job = 0; job < jobs.size(); ++job) {
+				job_offsets[job] = number_of_operations;
+				for (auto& task : jobs[job]) {
+					times.push_back(task.time);
+					machines.push_back(task.machine);
+					job_prev.push_back(task.index == 0 ? -1 : number_of_operations - 1);
+					job_next.push_back(task.index + 1 == jobs[job].size() ? -1 : number_of_operations + 1);
+					number_of_operations++;
+				}
+			}
+			machine_prev.assign(number_of_operations, -1);
+			machine_next.assign(number_of_operations, -1);
+			order.resize(number_of_operations);
+			positions.resize(number_of_operations);
+			heads.assign(number_of_operations, 0);
+			tails.assign(number_of_operations, 0);
+			marks.assign(number_of_operations, 0);
+			counts.assign(number_of_operations, 0);
+		}
+
+		int operation(int job, int index) const {
+			return job_offsets[job] + index;
+		}
+		const jssp::Task& task(int operation) const {
+			int job = std::upper_bound(job_offsets.begin(), job_offsets.end(), operation) - job_offsets.begin() - 1;
+			return jobs[job][operation - job_offsets[job]];
+		}
+		bool is_critical(int operation) const {
+			return heads[operation] + times[operation] + tails[operation] == makespan;
+		}
+
+		// the machine sequences are the order of the tasks of the schedule on every machine. like bnb.cpp, only the
+		// jobs of its tasks are read, the k-th task of a job in the schedule is its task of index k
+		void set_schedule(const jssp::Schedule& schedule) {
+			std::vector<int> machine_last(number_of_machines, -1);
+			std::vector<int> task_indices(jobs.size(), 0);
+			std::fill(machine_first.begin(), machine_first.end(), -1);
+			for (auto& scheduled : schedule) {
+				auto& task = jobs[scheduled.job][task_indices[scheduled.job]++];
+				int operation = this->operation(task.job, task.index);
+				int last = machine_last[task.machine];
+				machine_prev[operation] = last;
+				machine_next[operation] = -1;
+				if (last == -1)
+					machine_first[task.machine] = operation;
+				else
+					machine_next[last] = operation;
+				machine_last[task.machine] = operation;
+			}
+			std::iota(order.begin(), order.end(), 0);
+			for (int operation = 0; operation < number_of_operations; ++operation)
+				positions[operation] = operation;
+			sort_topologically(0, number_of_operations - 1);
+			for (int operation : order)
+				update_head(operation);
+			// in start time order the operations next to each other on a machine are close, so are the ranges a move
+			// re-sorts. it is still topological: the heads never decrease along an arc and the sort is stable
+			std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return heads[a] < heads[b]; });
+			for (int i = 0; i < number_of_operations; ++i)
+				positions[order[i]] = i;
+			for (int i = number_of_operations - 1; i >= 0; --i)
+				update_tail(order[i]);
+			update_makespan();
+		}
+
+		// the operations by increasing head, which is a schedule whose makespan_schedule is the makespan of the graph
+		jssp::Schedule get_schedule() const {
+			std::vector<int> sorted = order;
+			std::sort(sorted.begin(), sorted.end(), [&](int a, int b) {
+				return std::tie(heads[a], positions[a]) < std::tie(heads[b], positions[b]);
+			});
+			jssp::Schedule schedule;
+			schedule.reserve(number_of_operations);
+			for (int operation : sorted)
+				schedule.push_back(task(operation));
+			return schedule;
+		}
+
+		// re-sorts the operations at the positions [first, last] of the order, the others keep theirs. every arc that
+		// goes backwards in the order must have both ends in the range. returns false, and leaves the order as it was,
+		// if the range has a cycle
+		bool sort_topologically(int first, int last) {
+			stamp++;
+			for (int i = first; i <= last; ++i)
+				marks[order[i]] = stamp;
+			ready.clear();
+			for (int i = first; i <= last; ++i) {
+				int operation = order[i];
+				counts[operation] = 0;
+				for (int prev : {job_prev[operation], machine_prev[operation]})
+					counts[operation] += prev != -1 and marks[prev] == stamp;
+				if (counts[operation] == 0)
+					ready.push_back(operation);
+			}
+			window.clear();
+			while (not ready.empty()) {
+				int operation = ready.back();
+				ready.pop_back();
+				window.push_back(operation);
+				for (int next : {job_next[operation], machine_next[operation]})
+					if (next != -1 and marks[next] == stamp and --counts[next] == 0)
+						ready.push_back(next);
+			}
+			if (window.size() != last - first + 1)
+				return false;
+			for (int i = 0; i < window.size(); ++i) {
+				order[first + i] = window[i];
+				positions[window[i]] = first + i;
+			}
+			return true;
+		}
+
+		bool update_head(int operation) {
+			int head = 0;
+			for (int prev : {job_prev[operation], machine_prev[operation]})
+				if (prev != -1)
+					head = std::max(head, heads[prev] + times[prev]);
+			std::swap(heads[operation], head);
+			return head != heads[operation];
+		}
+		bool update_tail(int operation) {
+			int tail = 0;
+			for (int next : {job_next[operation], machine_next[operation]})
+				if (next != -1)
+					tail = std::max(tail, tails[next] + times[next]);
+			std::swap(tails[operation], tail);
+			return tail != tails[operation];
+		}
+		// the longest path ends with the last operation of a job
+		void update_makespan() {
+			makespan = 0;
+			for (int job = 0; job < jobs.size(); ++job) {
+				if (jobs[job].empty())
+					continue;
+				int last = operation(job, jobs[job].size() - 1);
+				makespan = std::max(makespan, heads[last] + times[last]);
+			}
+		}
+
+		// recomputes the heads of the seeds, whose predecessors changed, and of the operations after them whose heads
+		// change in consequence. the operations are taken in topological order, so each is computed once
+		void propagate_heads(std::span<const int> seeds) {
+			stamp++;
+			queue.clear();
+			auto later = std::greater<int>{};
+			auto enqueue = [&](int operation) {
+				if (operation != -1 and marks[operation] != stamp) {
+					marks[operation] = stamp;
+					queue.push_back(positions[operation]);
+					std::push_heap(queue.begin(), queue.end(), later);
+				}
+			};
+			for (int seed : seeds)
+				enqueue(seed);
+			while (not queue.empty()) {
+				std::pop_heap(queue.begin(), queue.end(), later);
+				int operation = order[queue.back()];
+				queue.pop_back();
+				if (update_head(operation)) {
+					enqueue(job_next[operation]);
+					enqueue(machine_next[operation]);
+				}
+			}
+		}
+		void propagate_heads(std::initializer_list<int> seeds) {
+			propagate_heads(std::span(seeds.begin(), seeds.size()));
+		}
+		// the same for the tails, in reverse topological order
+		void propagate_tails(std::span<const int> seeds) {
+			stamp++;
+			queue.clear();
+			auto enqueue = [&](int operation) {
+				if (operation != -1 and marks[operation] != stamp) {
+					marks[operation] = stamp;
+					queue.push_back(positions[operation]);
+					std::push_heap(queue.begin(), queue.end());
+				}
+			};
+			for (int seed : seeds)
+				enqueue(seed);
+			while (not queue.empty()) {
+				std::pop_heap(queue.begin(), queue.end());
+				int operation = order[queue.back()];
+				queue.pop_back();
+				if (update_tail(operation)) {
+					enqueue(job_prev[operation]);
+					enqueue(machine_prev[operation]);
+				}
+			}
+		}
+
+		void propagate_tails(std::initializer_list<int> seeds) {
+			propagate_tails(std::span(seeds.begin(), seeds.size()));
+		}
+
+		void unlink(int operation) {
+			int prev = machine_prev[operation];
+			int next = machine_next[operation];
+			if (prev == -1)
+				machine_first[machines[operation]] = next;
+			else
+				machine_next[prev] = next;
+			if (next != -1)
+				machine_prev[next] = prev;
+		}
+		// inserts the unlinked operation after prev on its machine, at the front if prev is -1
+		void link_after(int operation, int prev) {
+			int machine = machines[operation];
+			int next = prev == -1 ? machine_first[machine] : machine_next[prev];
+			machine_prev[operation] = prev;
+			machine_next[operation] = next;
+			if (prev == -1)
+				machine_first[machine] = operation;
+			else
+				machine_next[prev] = operation;
+			if (next != -1)
+				machine_prev[next] = operation;
+		}
+
+		// moves the operation right after prev, an operation of the same machine or -1 for the front, and updates the
+		// heads and tails. a move that creates a cycle is undone and returns false
+		bool move_after(int operation, int prev) {
+			int old_prev = machine_prev[operation];
+			if (prev == old_prev or prev == operation)
+				return true;
+			int old_next = machine_next[operation];
+			unlink(operation);
+			link_after(operation, prev);
+			int next = machine_next[operation];
+
+			// the new arcs prev -> operation -> next may go backwards in the order, the arc old_prev -> old_next can't
+			int first = number_of_operations;
+			int last = -1;
+			for (auto [from, to] : {std::pair(prev, operation), std::pair(operation, next)}) {
+				if (from != -1 and to != -1 and positions[from] > positions[to]) {
+					first = std::min(first, positions[to]);
+					last = std::max(last, positions[from]);
+				}
+			}
+			if (last != -1 and not sort_topologically(first, last)) {
+				unlink(operation);
+				link_after(operation, old_prev);
+				return false;
+			}
+			// the heads change from the operations that got new predecessors on, the tails from the ones that got new
+			// successors
+			propagate_heads({old_next, operation, next});
+			propagate_tails({old_prev, operation, prev});
+			update_makespan();
+			return true;
+		}
+		// links the operations of the sequence one after the other between prev and next, -1 for the ends of the machine
+		void link_run(int prev, int next, const int* sequence, int length) {
+			for (int k = 0; k < length; ++k) {
+				machine_prev[sequence[k]] = k == 0 ? prev : sequence[k - 1];
+				machine_next[sequence[k]] = k + 1 == length ? next : sequence[k + 1];
+			}
+			if (prev == -1)
+				machine_first[machines[sequence[0]]] = sequence[0];
+			else
+				machine_next[prev] = sequence[0];
+			if (next != -1)
+				machine_prev[next] = sequence[length - 1];
+		}
+		// puts the run of length operations that follows prev on its machine (-1 for the front) in the order of the
+		// sequence, which holds the same operations, and updates the heads and tails. the arcs that can go backwards in
+		// the order are inside the run, so only the positions between its first and last operation are re-sorted. a
+		// reordering that creates a cycle is undone and returns false
+		bool reorder(int prev, const int* sequence, int length) {
+			int machine = machines[sequence[0]];
+			old_run.clear();
+			for (int operation = prev == -1 ? machine_first[machine] : machine_next[prev]; old_run.size() < length; operation = machine_next[operation])
+				old_run.push_back(operation);
+			int next = machine_next[old_run.back()];
+			link_run(prev, next, sequence, length);
+			if (not sort_topologically(positions[old_run.front()], positions[old_run.back()])) {
+				link_run(prev, next, old_run.data(), length);
+				return false;
+			}
+			seeds.assign(sequence, sequence + length);
+			seeds.push_back(next);
+			propagate_heads(seeds);
+			seeds.back() = prev;
+			propagate_tails(seeds);
+			update_makespan();
+			return true;
+		}
+
+		// moves the operation right before next, an operation of the same machine
+		bool move_before(int operation, int next) {
+			int prev = machine_prev[next];
+			return move_after(operation, prev == operation ? machine_prev[operation] : prev);
+		}
+		// swaps the operation with the next one on its machine
+		bool swap_next(int operation) {
+			if (machine_next[operation] == -1)
+				return false;
+			return move_after(operation, machine_next[operation]);
+		}
+
+		// a longest path from the start to the end, following the machine arcs first so that the blocks are long. it
+		// starts with an operation that has no predecessor, which is the first of its job
+		CriticalPath critical_path() const {
+			CriticalPath path;
+			int operation = -1;
+			for (int job = 0; job < jobs.size() and operation == -1; ++job)
+				if (not jobs[job].empty() and heads[job_offsets[job]] == 0 and is_critical(job_offsets[job]))
+					operation = job_offsets[job];
+			while (operation != -1) {
+				path.operations.push_back(operation);
+				int end_time = heads[operation] + times[operation];
+				int next = -1;
+				for (int candidate : {machine_next[operation], job_next[operation]}) {
+					if (candidate != -1 and heads[candidate] == end_time and is_critical(candidate)) {
+						next = candidate;
+						break;
+					}
+				}
+				operation = next;
+			}
+			for (int begin = 0; begin < path.operations.size();) {
+				int end = begin + 1;
+				while (end < path.operations.size() and machines[path.operations[end]] == machines[path.operations[begin]])
+					end++;
+				path.blocks.emplace_back(begin, end);
+				begin = end;
+			}
+			return path;
+		}
+	};
+
+}
@@ -6,6 +6,10 @@
 #include <limits>
 #include <tuple>
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <random>
 #include "util.cpp"
 
 namespace jssp {
@@ -200,6 +204,91 @@ namespace jssp {
 		return *std::max_element(job_times.begin(), job_times.end());
 	}
 
+	// start time of every task of the schedule, in schedule order, with the same semantics as makespan_schedule
+	std::vector<int> start_times_schedule(const Schedule& schedule, int j, int m) {
+		std::vector<int> machine_times(m, 0);
+		std::vector<int> job_times(j, 0);
+		std::vector<int> start_times(schedule.size());
+
+		for (int i = 0; i < schedule.size(); ++i) {
+			auto& task = schedule[i];
+			start_times[i] = std::max(machine_times[task.machine], job_times[task.job]);
+			machine_times[task.machine] = start_times[i] + task.time;
+			job_times[task.job] = start_times[i] + task.time;
+		}
+
+		return start_times;
+	}
+
+	// scratch of left_shift_schedule, kept by the callers that compact often so that it doesn't allocate
+	struct LeftShiftBuffers {
+		std::vector<int> start_times;
+		std::vector<int> order;
+		std::vector<int> machine_times;
+		std::vector<int> job_times;
+		std::vector<std::vector<std::pair<int, int>>> machine_intervals; // (start, end) of the placed tasks, by start
+		Schedule shifted;
+	};
+
+	// global left shift: in the order of their start times, every task moves to the earliest idle gap of its machine
+	// that is long enough and after the end of its job predecessor, which turns a semi-active schedule into an active
+	// one. no task starts later than before, so the makespan never grows. the schedule is rewritten in the order of
+	// the new start times and its makespan returned
+	int left_shift_schedule(Schedule& schedule, int j, int m, LeftShiftBuffers& buffers) {
+		auto& start_times = buffers.start_times;
+		auto& order = buffers.order;
+		auto& machine_times = buffers.machine_times;
+		auto& job_times = buffers.job_times;
+		auto& machine_intervals = buffers.machine_intervals;
+		auto& shifted = buffers.shifted;
+
+		start_times.resize(schedule.size());
+		machine_times.assign(m, 0);
+		job_times.assign(j, 0);
+		for (int i = 0; i < schedule.size(); ++i) {
+			auto& task = schedule[i];
+			start_times[i] = std::max(machine_times[task.machine], job_times[task.job]);
+			machine_times[task.machine] = start_times[i] + task.time;
+			job_times[task.job] = start_times[i] + task.time;
+		}
+		machine_intervals.resize(m);
+		for (auto& intervals : machine_intervals)
+			intervals.clear();
+		order.resize(schedule.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return start_times[a] < start_times[b]; });
+
+		std::fill(job_times.begin(), job_times.end(), 0);
+		int makespan = 0;
+		for (int i : order) {
+			auto& task = schedule[i];
+			auto& intervals = machine_intervals[task.machine];
+			// the first gap after the job predecessor that fits the task, or the end of the machine
+			int start = job_times[task.job];
+			int position = 0;
+			for (; position < intervals.size(); ++position) {
+				if (start + task.time <= intervals[position].first)
+					break;
+				start = std::max(start, intervals[position].second);
+			}
+			intervals.insert(intervals.begin() + position, {start, start + task.time});
+			start_times[i] = start;
+			job_times[task.job] = start + task.time;
+			makespan = std::max(makespan, start + task.time);
+		}
+
+		std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return start_times[a] < start_times[b]; });
+		shifted.clear();
+		for (int i : order)
+			shifted.push_back(schedule[i]);
+		std::swap(schedule, shifted);
+		return makespan;
+	}
+	int left_shift_schedule(Schedule& schedule, int j, int m) {
+		LeftShiftBuffers buffers;
+		return left_shift_schedule(schedule, j, m, buffers);
+	}
+
 	void print_jobs(const jssp::Jobs& jobs) {
 		for (const auto& job : jobs) {
 			for (const auto& task : job) {
@@ -389,5 +478,50 @@ namespace jssp {
 		return schedule;
 	}
 
+	// best schedule shared by solvers running side by side. the makespan is mirrored in a lock-free atomic int so that
+	// a solver can prune with it on every node. the schedule is an immutable snapshot swapped in as a whole with a
+	// compare and exchange on an atomic shared_ptr. that one is not lock-free: libstdc++ guards it with an internal
+	// spinlock held only while the pointer is copied or swapped, never while a schedule is built or copied
+	struct SharedIncumbent {
+		struct Solution {
+			int makespan;
+			Schedule schedule;
+		};
+
+		std::atomic<int> makespan = std::numeric_limits<int>::max();
+		std::atomic<std::shared_ptr<const Solution>> solution;
+		std::atomic<bool> optimal = false; // a solver proved that nothing better than makespan exists
+
+		int get() const {
+			return makespan.load(std::memory_order_acquire);
+		}
+		// returns true if the schedule became the incumbent
+		bool offer(int new_makespan, Schedule schedule) {
+			if (new_makespan >= get())
+				return false;
+			auto candidate = std::make_shared<const Solution>(new_makespan, std::move(schedule));
+			auto current = solution.load();
+			do {
+				if (current != nullptr and current->makespan <= new_makespan)
+					return false;
+			} while (not solution.compare_exchange_weak(current, candidate));
+			// another offer may have won the exchange in between, the mirror only ever decreases
+			int mirrored = get();
+			while (new_makespan < mirrored and not makespan.compare_exchange_weak(mirrored, new_makespan));
+			return true;
+		}
+		// null until a schedule was offered
+		std::shared_ptr<const Solution> best() const {
+			return solution.load();
+		}
+
+		void prove_optimal() {
+			optimal.store(true, std::memory_order_release);
+		}
+		bool is_optimal() const {
+			return optimal.load(std::memory_order_acquire);
+		}
+	};
+
 
 }
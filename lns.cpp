@@ -0,0 +1,238 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <limits>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "bnb.cpp"
+#include "beam.cpp"
+
+namespace lns {
+
+	// the tasks at positions [begin, end) of the schedule, which is kept in start time order so that every prefix of it
+	// is closed under the job and machine precedences. the window's tasks on the machines that are not free keep their
+	// order
+	struct Window {
+		int begin;
+		int end;
+		std::vector<char> free_machines;
+	};
+
+	// new order of the tasks of a window, empty if the branch and bound found nothing as good as the current one
+	struct Repair {
+		jssp::Schedule tasks;
+		bool optimal; // the branch and bound searched the whole window within its node budget
+	};
+
+	// large neighborhood search: every round frees disjoint windows of the best schedule, re-optimizes each of them
+	// with the branch and bound of bnb.cpp in its own thread and puts the new orders back one after the other, keeping
+	// the ones that don't make the schedule longer. a window is solved as a subproblem whose machines and jobs are
+	// released when the tasks before the window end and delivered after the longest path through the tasks after the
+	// window, so its makespan is the one of the whole schedule. the window size adapts to the node budget: it grows
+	// after the windows the branch and bound solved to optimality and shrinks after the others
+	struct Lns : util::SearchLimits {
+
+		const jssp::Jobs& jobs;
+		int number_of_machines;
+		int number_of_tasks;
+
+		int rounds = 1000;
+		int window_size = 30; // tasks of a window, kept between min_window_size and max_window_size
+		int min_window_size = 10;
+		int max_window_size = 120;
+		float machine_subset_probability = 0.5f; // chance that only the window's tasks on half of the machines are free
+		long window_nodes = 2000; // node budget of the branch and bound of a window
+		size_t window_table_size = 1 << 12; // transposition table slots of the branch and bound of a window
+		int number_of_threads = 0; // 0 means one per hardware thread
+
+		jssp::Schedule schedule; // best schedule, in start time order
+		int best_makespan = std::numeric_limits<int>::max();
+		std::mt19937 random_engine;
+
+		Lns(const jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines),
+			number_of_tasks(jobs.size() * number_of_machines), random_engine(std::random_device()()) {}
+
+		void set_rounds(int rounds) {
+			this->rounds = rounds;
+		}
+		void set_window_size(int window_size, int min_window_size, int max_window_size) {
+			this->min_window_size = std::max(1, min_window_size);
+			this->max_window_size = std::max(this->min_window_size, max_window_size);
+			this->window_size = std::clamp(window_size, this->min_window_size, this->max_window_size);
+		}
+		void set_machine_subset_probability(float machine_subset_probability) {
+			this->machine_subset_probability = std::clamp(machine_subset_probability, 0.f, 1.f);
+		}
+		void set_window_nodes(long window_nodes) {
+			this->window_nodes = window_nodes;
+		}
+		void set_number_of_threads(int number_of_threads) {
+			this->number_of_threads = number_of_threads;
+		}
+		void set_seed(unsigned seed) {
+			random_engine.seed(seed);
+		}
+		// schedule to improve, by default the one of a beam search. only the jobs of its tasks are read
+		void set_initial_schedule(const jssp::Schedule& initial_schedule) {
+			std::vector<int> task_indices(jobs.size(), 0);
+			schedule.clear();
+			for (auto& task : initial_schedule)
+				schedule.push_back(jobs[task.job][task_indices[task.job]++]);
+			sort_by_start_time();
+			best_makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
+		}
+
+		int number_of_workers() const {
+			int workers = number_of_threads > 0 ? number_of_threads : std::thread::hardware_concurrency();
+			return std::max(1, workers);
+		}
+
+		// stable, so the order of the tasks of a machine or a job never changes
+		void sort_by_start_time() {
+			auto start_times = jssp::start_times_schedule(schedule, jobs.size(), number_of_machines);
+			std::vector<int> order(schedule.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return start_times[a] < start_times[b]; });
+			jssp::Schedule sorted;
+			sorted.reserve(schedule.size());
+			for (int i : order)
+				sorted.push_back(schedule[i]);
+			schedule = std::move(sorted);
+		}
+
+		// disjoint windows, one in every equal part of the schedule
+		std::vector<Window> pick_windows() {
+			int workers = std::clamp(number_of_tasks / window_size, 1, number_of_workers());
+			std::bernoulli_distribution machine_subset(machine_subset_probability);
+			std::vector<Window> windows;
+			for (int worker = 0; worker < workers; ++worker) {
+				int part_begin = number_of_tasks * worker / workers;
+				int part_end = number_of_tasks * (worker + 1) / workers;
+				Window window = {0, 0, std::vector<char>(number_of_machines, true)};
+				int size = window_size;
+				if (machine_subset(random_engine)) {
+					// the fixed machines leave fewer decisions, the window spans twice as many tasks
+					std::vector<int> machines(number_of_machines);
+					std::iota(machines.begin(), machines.end(), 0);
+					std::shuffle(machines.begin(), machines.end(), random_engine);
+					for (int i = 0; i < number_of_machines / 2; ++i)
+						window.free_machines[machines[i]] = false;
+					size *= 2;
+				}
+				size = std::min(size, part_end - part_begin);
+				window.begin = std::uniform_int_distribution(part_begin, part_end - size)(random_engine);
+				window.end = window.begin + size;
+				windows.push_back(std::move(window));
+			}
+			return windows;
+		}
+
+		// re-optimizes the window of the schedule with the branch and bound, looking for an order at least as good as
+		// the current one for the subproblem
+		Repair repair(const Window& window, const std::vector<int>& start_times) const {
+			int number_of_jobs = jobs.size();
+			DfsOptions options;
+			options.transposition_table_size = window_table_size;
+			options.machine_release_times.assign(number_of_machines, 0);
+			options.job_release_times.assign(number_of_jobs, 0);
+			for (int i = 0; i < window.begin; ++i) {
+				auto& task = schedule[i];
+				int end_time = start_times[i] + task.time;
+				options.machine_release_times[task.machine] = std::max(options.machine_release_times[task.machine], end_time);
+				options.job_release_times[task.job] = std::max(options.job_release_times[task.job], end_time);
+			}
+
+			// the window's tasks of every job, indexed from 0 inside the subproblem
+			jssp::Jobs window_jobs(number_of_jobs);
+			std::vector<int> first_indices(number_of_jobs, -1);
+			bool fixed_machines = std::count(window.free_machines.begin(), window.free_machines.end(), false) > 0;
+			if (fixed_machines)
+				options.machine_orders.assign(number_of_machines, {});
+			for (int i = window.begin; i < window.end; ++i) {
+				jssp::Task task = schedule[i];
+				if (first_indices[task.job] == -1)
+					first_indices[task.job] = task.index;
+				if (not window.free_machines[task.machine])
+					options.machine_orders[task.machine].push_back(task.job);
+				task.index = window_jobs[task.job].size();
+				window_jobs[task.job].push_back(task);
+			}
+			// the tasks after the window keep their order, so the longest path from the first of them of every job and
+			// machine to the end of the schedule follows the window's tasks of the job or machine
+			options.job_delivery_times.assign(number_of_jobs, 0);
+			options.machine_delivery_times.assign(number_of_machines, 0);
+			for (int i = schedule.size() - 1; i >= window.end; --i) {
+				auto& task = schedule[i];
+				int tail = task.time + std::max(options.job_delivery_times[task.job], options.machine_delivery_times[task.machine]);
+				options.job_delivery_times[task.job] = tail;
+				options.machine_delivery_times[task.machine] = tail;
+			}
+
+			// the current order of the window bounds the search, ties are accepted to move along plateaus
+			SearchState current(window_jobs, number_of_machines);
+			current.set_subproblem(options);
+			for (int i = window.begin; i < window.end; ++i)
+				current.push(schedule[i].job);
+			options.upper_bound = current.makespan + 1;
+
+			util::SearchLimits limits;
+			limits.set_max_evaluations(window_nodes);
+			limits.set_cancel_token(cancel_token);
+			options.limits = &limits;
+			DfsResult result = dfs_optimized(window_jobs, number_of_machines, std::move(options));
+
+			Repair repair = {{}, result.optimal};
+			for (auto& task : result.schedule)
+				repair.tasks.push_back(jobs[task.job][first_indices[task.job] + task.index]);
+			return repair;
+		}
+
+		// improves the initial schedule and returns the best one, best_makespan holds its makespan
+		jssp::Schedule run() {
+			start_limits();
+			if (schedule.empty()) {
+				beam::BeamSearch beam_search(jobs, number_of_machines);
+				beam_search.set_number_of_threads(number_of_threads);
+				set_initial_schedule(beam_search.run());
+			}
+			report_improvement(best_makespan);
+
+			for (int round = 0; round < rounds and not should_stop(); ++round) {
+				auto windows = pick_windows();
+				auto start_times = jssp::start_times_schedule(schedule, jobs.size(), number_of_machines);
+				std::vector<Repair> repairs(windows.size());
+				std::vector<std::thread> thread_pool;
+				for (int i = 1; i < windows.size(); ++i)
+					thread_pool.emplace_back([&, i] { repairs[i] = repair(windows[i], start_times); });
+				repairs[0] = repair(windows[0], start_times);
+				for (auto& thread : thread_pool)
+					thread.join();
+
+				// the windows are disjoint, each new order is put back into the schedule the others changed
+				int old_makespan = best_makespan;
+				for (int i = 0; i < windows.size(); ++i) {
+					count_evaluation();
+					window_size = std::clamp(window_size + (repairs[i].optimal ? 1 : -1), min_window_size, max_window_size);
+					if (repairs[i].tasks.empty())
+						continue;
+					auto& window = windows[i];
+					jssp::Schedule old_tasks(schedule.begin() + window.begin, schedule.begin() + window.end);
+					std::copy(repairs[i].tasks.begin(), repairs[i].tasks.end(), schedule.begin() + window.begin);
+					int makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
+					if (makespan <= best_makespan)
+						best_makespan = makespan;
+					else
+						std::copy(old_tasks.begin(), old_tasks.end(), schedule.begin() + window.begin);
+				}
+				sort_by_start_time();
+				if (best_makespan < old_makespan)
+					report_improvement(best_makespan);
+			}
+			return schedule;
+		}
+	};
+
+}
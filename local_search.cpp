@@ -0,0 +1,207 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "graph.cpp"
+
+namespace local_search {
+
+	// moves of the operations of the blocks of a critical path, the only ones that can shorten it
+	enum class Neighborhood {
+		n5, // nowicki and smutnicki: swap the first two or the last two operations of a block, not at the ends of the path
+		n6, // balas and vazacopoulos: move an operation of a block right before its first or right after its last one
+		n7, // zhang et al.: n6, plus the first operation of a block right after an inner one and the last right before
+	};
+
+	// moves the operation right after prev on its machine, -1 for the front
+	struct Move {
+		int operation;
+		int prev;
+		int estimate; // makespan of the longest path through the moved operations after the move
+	};
+
+	// descent on the critical block neighborhoods of the disjunctive graph of a schedule. the moves are estimated in
+	// time proportional to the operations they reorder from the heads and tails of the graph, and the promising ones
+	// are applied with the incremental update of the graph, which gives the exact makespan, and undone if it's not
+	// better. steepest descent tries the moves by increasing estimate, first improvement in the order of the path
+	struct LocalSearch {
+
+		graph::DisjunctiveGraph graph;
+		Neighborhood neighborhood = Neighborhood::n6;
+		bool first_improvement = false;
+		int max_steps = std::numeric_limits<int>::max(); // improving moves applied per run
+
+		// totals over the runs
+		long steps = 0;
+		long applied_moves = 0; // moves applied to verify their estimate, improving or not
+
+		std::vector<Move> moves;
+		// scratch of estimate
+		std::vector<int> sequence;
+		std::vector<int> sequence_heads;
+
+		LocalSearch(const jssp::Jobs& jobs, int number_of_machines) : graph(jobs, number_of_machines) {}
+
+		void set_neighborhood(Neighborhood neighborhood) {
+			this->neighborhood = neighborhood;
+		}
+		void set_first_improvement(bool first_improvement) {
+			this->first_improvement = first_improvement;
+		}
+		void set_max_steps(int max_steps) {
+			this->max_steps = max_steps;
+		}
+
+		// end of the job predecessor and start of the tail of the job successor, which a move doesn't change
+		int job_head(int operation) const {
+			int prev = graph.job_prev[operation];
+			return prev == -1 ? 0 : graph.heads[prev] + graph.times[prev];
+		}
+		int job_tail(int operation) const {
+			int next = graph.job_next[operation];
+			return next == -1 ? 0 : graph.tails[next] + graph.times[next];
+		}
+
+		// heads of the reordered operations from the one before them on the machine, tails from the one after them,
+		// and the longest path through them. exact for a swap, an estimate when the job predecessors or successors of
+		// the operations in between are moved too
+		int estimate(int operation, int prev) {
+			sequence.clear();
+			int before;
+			int after;
+			auto& machine_prev = graph.machine_prev;
+			auto& machine_next = graph.machine_next;
+			if (prev != -1 and graph.heads[prev] > graph.heads[operation]) {
+				// forward: operation, ..., prev becomes ..., prev, operation
+				before = machine_prev[operation];
+				after = machine_next[prev];
+				for (int other = machine_next[operation]; other != after; other = machine_next[other])
+					sequence.push_back(other);
+				sequence.push_back(operation);
+			} else {
+				// backward: next, ..., operation becomes operation, next, ...
+				before = prev;
+				after = machine_next[operation];
+				sequence.push_back(operation);
+				int first = prev == -1 ? graph.machine_first[graph.machines[operation]] : machine_next[prev];
+				for (int other = first; other != operation; other = machine_next[other])
+					sequence.push_back(other);
+			}
+
+			return estimate_sequence(before, after);
+		}
+		// the longest path through the operations of sequence, once they follow before and precede after on their
+		// machine, -1 for the ends
+		int estimate_sequence(int before, int after) {
+			int time = before == -1 ? 0 : graph.heads[before] + graph.times[before];
+			auto& heads = sequence_heads;
+			heads.resize(sequence.size());
+			for (int i = 0; i < sequence.size(); ++i) {
+				heads[i] = std::max(time, job_head(sequence[i]));
+				time = heads[i] + graph.times[sequence[i]];
+			}
+			int tail = after == -1 ? 0 : graph.tails[after] + graph.times[after];
+			int longest = 0;
+			for (int i = sequence.size() - 1; i >= 0; --i) {
+				tail = std::max(tail, job_tail(sequence[i]));
+				longest = std::max(longest, heads[i] + graph.times[sequence[i]] + tail);
+				tail += graph.times[sequence[i]];
+			}
+			return longest;
+		}
+
+		void add_move(int operation, int prev) {
+			if (prev == operation or prev == graph.machine_prev[operation])
+				return;
+			moves.push_back({operation, prev, 0});
+		}
+		// the operation right after a later operation of its block. it can't create a cycle if the tail of the target
+		// is at least the one of the job successor of the operation (balas and vazacopoulos), a swap never does
+		void add_forward_move(int operation, int target) {
+			int next = graph.job_next[operation];
+			if (graph.machine_next[operation] == target or next == -1 or
+				graph.tails[target] + graph.times[target] >= graph.tails[next] + graph.times[next])
+				add_move(operation, target);
+		}
+		// the operation right before an earlier operation of its block, symmetrically with the heads
+		void add_backward_move(int operation, int target) {
+			int prev = graph.job_prev[operation];
+			if (graph.machine_prev[operation] == target or prev == -1 or
+				graph.heads[target] + graph.times[target] >= graph.heads[prev] + graph.times[prev])
+				add_move(operation, graph.machine_prev[target]);
+		}
+
+		// the moves of the neighborhood of the critical path
+		void generate_moves(const graph::CriticalPath& path) {
+			moves.clear();
+			auto& operations = path.operations;
+			for (int b = 0; b < path.blocks.size(); ++b) {
+				auto [begin, end] = path.blocks[b];
+				if (end - begin < 2)
+					continue;
+				int first = operations[begin];
+				int last = operations[end - 1];
+				if (neighborhood == Neighborhood::n5) {
+					if (b > 0)
+						add_move(first, operations[begin + 1]);
+					if (b + 1 < path.blocks.size() and (b == 0 or end - begin > 2))
+						add_move(operations[end - 2], last);
+					continue;
+				}
+				for (int i = begin; i < end - 1; ++i)
+					add_forward_move(operations[i], last);
+				// in a block of two the backward move is the same swap
+				for (int i = begin + 1; i < end and end - begin > 2; ++i)
+					add_backward_move(operations[i], first);
+				// the moves next to the first or last operation are swaps n6 already has
+				if (neighborhood == Neighborhood::n7) {
+					for (int i = begin + 2; i < end - 1; ++i)
+						add_forward_move(first, operations[i]);
+					for (int i = begin + 1; i < end - 2; ++i)
+						add_backward_move(last, operations[i]);
+				}
+			}
+		}
+
+		// improves the schedule in place and returns its makespan
+		int run(jssp::Schedule& schedule) {
+			graph.set_schedule(schedule);
+			int initial_makespan = graph.makespan;
+			for (int step = 0; step < max_steps; ++step) {
+				generate_moves(graph.critical_path());
+				for (auto& move : moves)
+					move.estimate = estimate(move.operation, move.prev);
+				if (not first_improvement)
+					std::stable_sort(moves.begin(), moves.end(), [](const Move& a, const Move& b) { return a.estimate < b.estimate; });
+
+				bool improved = false;
+				for (auto& move : moves) {
+					if (move.estimate >= graph.makespan) {
+						if (first_improvement)
+							continue;
+						break;
+					}
+					int makespan = graph.makespan;
+					int old_prev = graph.machine_prev[move.operation];
+					applied_moves++;
+					if (not graph.move_after(move.operation, move.prev))
+						continue;
+					if (graph.makespan < makespan) {
+						improved = true;
+						break;
+					}
+					graph.move_after(move.operation, old_prev);
+				}
+				if (not improved)
+					break;
+				steps++;
+			}
+			if (graph.makespan < initial_makespan)
+				schedule = graph.get_schedule();
+			return graph.makespan;
+		}
+	};
+
+}
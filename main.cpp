@@ -7,6 +7,16 @@
 #include "jssp.cpp"
 #include "parse.cpp"
 #include "pso2.cpp"
+#include "beam.cpp"
+#include "lns.cpp"
+#include "graph.cpp"
+#include "local_search.cpp"
+#include "tabu.cpp"
+#include "brkga.cpp"
+#include "relinking.cpp"
+#include "archive.cpp"
+#include "annealing.cpp"
+#include "vnd.cpp"
 
 template<bool Log = false>
 void grid_search(jssp::Jobs& jobs, int j, int m, std::function<void(float,float,float,int)> callback = nullptr) {
@@ -56,6 +66,502 @@ void test_pso() {
 	util::println("Best makespan: {}", pso.gbest_makespan);
 }	
 
+void test_beam() {
+	int j = 50;
+	int m = 15;
+	std::string benchmark = util::format("experiments/benchmarks/tai{}_{}.txt", j, m);
+	jssp::Jobs jobs = load_jobs(benchmark)[0];
+
+	util::stopwatch sw;
+	beam::BeamSearch beam_search(jobs, m);
+	beam_search.set_beam_width(64);
+	jssp::Schedule schedule = beam_search.run();
+	util::println("Best makespan: {} in {} ms", beam_search.best_makespan, sw.elapsed<util::milliseconds>().count());
+}
+
+// makespan and time of the pso of benchmark_pso2_parallel on an instance, the reference of the other benchmarks
+std::pair<int, util::milliseconds> run_reference_pso(jssp::Jobs& jobs, int m) {
+	util::stopwatch sw;
+	pso::Pso pso(jobs, m);
+	pso.set_iterations(500);
+	pso.set_number_of_particles(100);
+	pso.set_w(0.3f);
+	pso.set_c1(0.1f);
+	pso.set_c2(0.9f);
+	pso.set_delta(0);
+	pso.init_swarm();
+	pso.run_parallal();
+	return {pso.get_best_makespan(), sw.elapsed<util::milliseconds>()};
+}
+
+// logs the makespan and time of the beam search, of the shortest starting time rule and of the pso for each benchmark
+void benchmark_beam() {
+	std::string filename = "experiments/results/beam-benchmark.csv";
+	util::write(filename, "jobs machines,instance,beam width,makespan,time ms,sst makespan,pso makespan,pso time ms\n", std::ios::out | std::ios::trunc);
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			auto sst = jssp::generate_schedule_shortest_starting_time(instances[i], m);
+			int sst_makespan = jssp::makespan_schedule(sst, j, m);
+			auto [pso_makespan, pso_time] = run_reference_pso(instances[i], m);
+			for (int beam_width : {16, 64, 256}) {
+				util::stopwatch sw;
+				beam::BeamSearch beam_search(instances[i], m);
+				beam_search.set_beam_width(beam_width);
+				beam_search.run();
+				std::string line = util::format("{} {},{},{},{},{:.0f},{},{},{:.0f}\n", j, m, i, beam_width, beam_search.best_makespan,
+					sw.elapsed<util::milliseconds>().count(), sst_makespan, pso_makespan, pso_time.count());
+				util::print(line);
+				util::write(filename, line, std::ios::app);
+			}
+		}
+	};
+	std::vector instance_indices = {0, 1, 2, 3};
+	benchmark(20, 15, instance_indices);
+	benchmark(30, 15, instance_indices);
+	benchmark(50, 15, instance_indices);
+	benchmark(100, 20, instance_indices);
+}
+
+void test_lns() {
+	int j = 100;
+	int m = 20;
+	std::string benchmark = util::format("experiments/benchmarks/tai{}_{}.txt", j, m);
+	jssp::Jobs jobs = load_jobs(benchmark)[0];
+
+	lns::Lns lns(jobs, m);
+	lns.set_time_limit(util::seconds(10));
+	lns.set_rounds(std::numeric_limits<int>::max());
+	lns.set_on_improvement([](int makespan, long windows, util::milliseconds elapsed) {
+		util::println("{} ms: {} after {} windows", elapsed.count(), makespan, windows);
+	});
+	lns.run();
+	util::println("Best makespan: {}, window size: {}", lns.best_makespan, lns.window_size);
+}
+// beam search followed by the large neighborhood search for 10 seconds, against the pso alone
+void benchmark_lns() {
+	std::string filename = "experiments/results/lns-benchmark.csv";
+	util::write(filename, "jobs machines,instance,beam makespan,lns makespan,windows,pso makespan,pso time ms\n", std::ios::out | std::ios::trunc);
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			auto [pso_makespan, pso_time] = run_reference_pso(instances[i], m);
+			beam::BeamSearch beam_search(instances[i], m);
+			auto schedule = beam_search.run();
+			lns::Lns lns(instances[i], m);
+			lns.set_initial_schedule(schedule);
+			lns.set_time_limit(util::seconds(10));
+			lns.set_rounds(std::numeric_limits<int>::max());
+			lns.run();
+			std::string line = util::format("{} {},{},{},{},{},{},{:.0f}\n", j, m, i, beam_search.best_makespan, lns.best_makespan,
+				lns.evaluations.load(), pso_makespan, pso_time.count());
+			util::print(line);
+			util::write(filename, line, std::ios::app);
+		}
+	};
+	std::vector instance_indices = {0, 1, 2, 3};
+	benchmark(50, 15, instance_indices);
+	benchmark(100, 20, instance_indices);
+}
+
+// random moves on the disjunctive graph of a schedule, the incremental heads must give the makespan of the schedule
+void test_graph() {
+	int j = 20;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	graph::DisjunctiveGraph graph(jobs, m);
+	graph.set_schedule(jssp::generate_schedule_shortest_starting_time(jobs, m));
+
+	std::mt19937 engine(1);
+	int moves = 0;
+	int errors = 0;
+	util::stopwatch sw;
+	for (int i = 0; i < 10000; ++i) {
+		auto path = graph.critical_path();
+		int operation = path.operations[engine() % path.operations.size()];
+		int machine = graph.machines[operation];
+		std::vector<int> sequence;
+		for (int other = graph.machine_first[machine]; other != -1; other = graph.machine_next[other])
+			sequence.push_back(other);
+		moves += graph.move_after(operation, sequence[engine() % sequence.size()]);
+		auto schedule = graph.get_schedule();
+		errors += jssp::makespan_schedule(schedule, j, m) != graph.makespan;
+	}
+	util::println("{} moves, {} errors, makespan {} in {} ms", moves, errors, graph.makespan, sw.elapsed<util::milliseconds>().count());
+}
+
+// descent from the shortest starting time schedule in both neighborhoods, steepest and first improvement
+void test_local_search() {
+	int j = 50;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	auto sst = jssp::generate_schedule_shortest_starting_time(jobs, m);
+	util::println("SST makespan: {}", jssp::makespan_schedule(sst, j, m));
+	for (auto neighborhood : {local_search::Neighborhood::n5, local_search::Neighborhood::n6}) {
+		for (bool first_improvement : {false, true}) {
+			auto schedule = sst;
+			local_search::LocalSearch search(jobs, m);
+			search.set_neighborhood(neighborhood);
+			search.set_first_improvement(first_improvement);
+			util::stopwatch sw;
+			int makespan = search.run(schedule);
+			util::println("{} {}: {} after {} steps, {} applied moves, {} ms", neighborhood == local_search::Neighborhood::n5 ? "N5" : "N6",
+				first_improvement ? "first improvement" : "steepest", makespan, search.steps, search.applied_moves, sw.elapsed<util::milliseconds>().count());
+		}
+	}
+}
+
+void test_tabu() {
+	int j = 50;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	tabu::TabuSearch tabu_search(jobs, m);
+	tabu_search.set_time_limit(util::seconds(10));
+	tabu_search.set_on_improvement([](int makespan, long iterations, util::milliseconds elapsed) {
+		util::println("{} ms: {} after {} iterations", elapsed.count(), makespan, iterations);
+	});
+	tabu_search.run();
+	util::println("Best makespan: {}, lower bound: {}, restarts: {}", tabu_search.best_makespan, tabu_search.lower_bound, tabu_search.restarts);
+}
+// single threaded baseline for benchmark_pso2, same csv columns. the search stops at the time limit or when it
+// reaches the lower bound
+void benchmark_tabu() {
+	std::string filename = "experiments/results/tabu-benchmark.csv";
+	util::write(filename, "jobs machines,instance,makespan,time ms,\n", std::ios::out | std::ios::trunc);
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			util::stopwatch sw;
+			tabu::TabuSearch tabu_search(instances[i], m);
+			tabu_search.set_time_limit(util::seconds(10));
+			tabu_search.run();
+			auto elapsed = sw.elapsed<std::chrono::milliseconds>();
+			std::string line = util::format("{} {},{},{},{}\n", j, m, i, tabu_search.best_makespan, elapsed.count());
+			util::print(line);
+			util::write(filename, line, std::ios::app);
+		}
+	};
+	std::vector instance_indices = {0, 1, 2, 3};
+	benchmark(20, 15, instance_indices);
+	benchmark(30, 15, instance_indices);
+	benchmark(50, 15, instance_indices);
+	benchmark(100, 20, instance_indices);
+}
+
+void test_brkga() {
+	int j = 20;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	brkga::Brkga brkga(jobs, m);
+	brkga.set_generations(std::numeric_limits<int>::max());
+	brkga.set_number_of_populations(2);
+	brkga.set_delta(0);
+	brkga.set_time_limit(util::seconds(10));
+	brkga.set_on_improvement([](int makespan, long evaluations, util::milliseconds elapsed) {
+		util::println("{} ms: {} after {} evaluations", elapsed.count(), makespan, evaluations);
+	});
+	brkga.run();
+	util::println("Best makespan: {} after {} generations, {} exchanges", brkga.best_makespan, brkga.generation, brkga.exchanges);
+}
+// evaluations to target of the pso and the brkga on the same decoder and evaluation budget: the target is the
+// makespan the pso ends with, and the brkga's evaluations to reach it are -1 when it doesn't. both count the
+// evaluations of their initial population
+void benchmark_brkga() {
+	std::string filename = "experiments/results/brkga-benchmark.csv";
+	util::write(filename, "jobs machines,instance,pso makespan,pso evaluations,brkga makespan,brkga evaluations to target\n", std::ios::out | std::ios::trunc);
+	long budget = 50000;
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			long pso_evaluations = 0;
+			pso::Pso pso(instances[i], m);
+			pso.set_iterations(std::numeric_limits<int>::max());
+			pso.set_number_of_particles(100);
+			pso.set_w(0.3f);
+			pso.set_c1(0.1f);
+			pso.set_c2(0.9f);
+			pso.set_delta(0);
+			pso.set_max_evaluations(budget);
+			pso.set_on_improvement([&](int, long evaluations, util::milliseconds) { pso_evaluations = evaluations; });
+			pso.init_swarm();
+			pso.run_parallal();
+			int target = pso.get_best_makespan();
+
+			long brkga_evaluations = -1;
+			brkga::Brkga brkga(instances[i], m);
+			brkga.set_generations(std::numeric_limits<int>::max());
+			brkga.set_delta(0);
+			brkga.set_max_evaluations(budget);
+			brkga.set_on_improvement([&](int makespan, long evaluations, util::milliseconds) {
+				if (makespan <= target and brkga_evaluations == -1)
+					brkga_evaluations = evaluations;
+			});
+			brkga.run();
+			std::string line = util::format("{} {},{},{},{},{},{}\n", j, m, i, target, pso_evaluations, brkga.best_makespan, brkga_evaluations);
+			util::print(line);
+			util::write(filename, line, std::ios::app);
+		}
+	};
+	std::vector instance_indices = {0, 1};
+	benchmark(20, 15, instance_indices);
+	benchmark(30, 15, instance_indices);
+	benchmark(50, 15, instance_indices);
+}
+
+// the pbests a pso run ends with, relinked after the descent from its gbest alone
+void test_path_relinking() {
+	int j = 50;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	pso::Pso pso(jobs, m);
+	pso.set_iterations(std::numeric_limits<int>::max());
+	pso.set_number_of_particles(100);
+	pso.set_w(0.3f);
+	pso.set_c1(0.1f);
+	pso.set_c2(0.9f);
+	pso.set_delta(0);
+	pso.set_local_search(true);
+	pso.set_time_limit(util::seconds(5));
+	pso.init_swarm();
+	pso.run_parallal();
+	util::println("PSO makespan: {}, after the descent: {}", pso.gbest_makespan, pso.get_best_makespan());
+
+	util::stopwatch sw;
+	pso.set_path_relinking(true, 8);
+	// the run spent its time limit, the relinking gets a new one
+	pso.set_time_limit(util::seconds(5));
+	pso.start_limits();
+	pso.relink_pbests();
+	util::println("After path relinking: {} in {} ms", pso.get_best_makespan(), sw.elapsed<util::milliseconds>().count());
+}
+
+// two pso runs sharing an elite archive: the second one is warm started from the schedules the first one archived
+// and relinks them at the end
+void test_elite_archive() {
+	int j = 20;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	archive::EliteArchive elite_archive(jobs, m, 16, 50);
+	for (int run = 0; run < 2; ++run) {
+		pso::Pso pso(jobs, m);
+		pso.set_iterations(std::numeric_limits<int>::max());
+		pso.set_number_of_particles(100);
+		pso.set_w(0.3f);
+		pso.set_c1(0.1f);
+		pso.set_c2(0.9f);
+		pso.set_delta(0);
+		pso.set_stagnation_limit(50);
+		pso.set_elite_archive(&elite_archive);
+		if (run == 1) {
+			pso.set_warm_start_fraction(0.2f);
+			pso.set_path_relinking(true, 8);
+		}
+		pso.set_time_limit(util::seconds(3));
+		pso.init_swarm();
+		pso.run_parallal();
+		auto entries = elite_archive.get_entries();
+		int min_distance = std::numeric_limits<int>::max();
+		for (int a = 0; a < entries.size(); ++a)
+			for (int b = a + 1; b < entries.size(); ++b)
+				min_distance = std::min(min_distance, archive::distance(entries[a]->sequences, entries[b]->sequences, j));
+		util::println("Run {}: best makespan {}, archive {} to {}, {} entries at least {} apart, {} insertions out of {} offers", run,
+			pso.get_best_makespan(), entries.front()->makespan, entries.back()->makespan, entries.size(), min_distance,
+			elite_archive.insertions.load(), elite_archive.offers.load());
+	}
+}
+
+// cost and gain of the lamarckian left shift of the pso on the same evaluation budget, with the non-delay decoder
+// (delta 0) and the active one (delta 1)
+void benchmark_compaction() {
+	std::string filename = "experiments/results/compaction-benchmark.csv";
+	util::write(filename, "jobs machines,instance,delta,compaction,makespan,us per evaluation,compaction time %,compactions,gain\n", std::ios::out | std::ios::trunc);
+	long budget = 20000;
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			for (float delta : {0.f, 1.f}) {
+				for (auto [compaction, name] : {std::pair(pso::Compaction::none, "none"), std::pair(pso::Compaction::pbests, "pbests"),
+					std::pair(pso::Compaction::evaluations, "evaluations")}) {
+					pso::Pso pso(instances[i], m);
+					pso.set_iterations(std::numeric_limits<int>::max());
+					pso.set_number_of_particles(100);
+					pso.set_w(0.3f);
+					pso.set_c1(0.1f);
+					pso.set_c2(0.9f);
+					pso.set_delta(delta);
+					pso.set_compaction(compaction);
+					pso.set_max_evaluations(budget);
+					util::stopwatch sw;
+					pso.init_swarm();
+					pso.run();
+					auto elapsed = sw.elapsed<util::microseconds>().count();
+					std::string line = util::format("{} {},{},{},{},{},{:.1f},{:.1f},{},{}\n", j, m, i, delta, name, pso.gbest_makespan,
+						elapsed / pso.evaluations.load(), 100 * pso.compaction_time.load() / 1000.0 / elapsed, pso.compactions.load(), pso.compaction_gain.load());
+					util::print(line);
+					util::write(filename, line, std::ios::app);
+				}
+			}
+		}
+	};
+	benchmark(20, 15, {0});
+	benchmark(50, 15, {0});
+}
+
+void test_parallel_tempering() {
+	int j = 50;
+	int m = 15;
+	jssp::Jobs jobs = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m))[0];
+	annealing::ParallelTempering tempering(jobs, m);
+	tempering.set_number_of_threads(4);
+	tempering.set_time_limit(util::seconds(10));
+	tempering.set_on_improvement([](int makespan, long steps, util::milliseconds elapsed) {
+		util::println("{} ms: {} after {} steps", elapsed.count(), makespan, steps);
+	});
+	tempering.run();
+	util::println("Best makespan: {}, lower bound: {}, {} exchanges out of {} attempts", tempering.get_best_makespan(), tempering.lower_bound,
+		tempering.exchanges.load(), tempering.exchange_attempts.load());
+}
+
+// same csv columns as benchmark_tabu, 4 replicas for 10 seconds
+void benchmark_parallel_tempering() {
+	std::string filename = "experiments/results/parallel-tempering-benchmark.csv";
+	util::write(filename, "jobs machines,instance,makespan,time ms,\n", std::ios::out | std::ios::trunc);
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			util::stopwatch sw;
+			annealing::ParallelTempering tempering(instances[i], m);
+			tempering.set_number_of_threads(4);
+			tempering.set_time_limit(util::seconds(10));
+			tempering.run();
+			auto elapsed = sw.elapsed<std::chrono::milliseconds>();
+			std::string line = util::format("{} {},{},{},{}\n", j, m, i, tempering.get_best_makespan(), elapsed.count());
+			util::print(line);
+			util::write(filename, line, std::ios::app);
+		}
+	};
+	std::vector instance_indices = {0, 1, 2, 3};
+	benchmark(20, 15, instance_indices);
+	benchmark(30, 15, instance_indices);
+	benchmark(50, 15, instance_indices);
+	benchmark(100, 20, instance_indices);
+}
+
+// statistics of the move library over the instance mix: a descent from the shortest starting time schedule and from
+// random ones on the first instances of every benchmark, with the mean makespan of the n6 local search from the same
+// schedules for comparison
+void benchmark_vnd() {
+	std::string filename = "experiments/results/vnd-moves.csv";
+	util::write(filename, "jobs machines,move,estimates,evaluations,improvements,success rate,evaluations per s,gain per s,vnd makespan,n6 makespan\n", std::ios::out | std::ios::trunc);
+	std::mt19937 engine(1);
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		long vnd_makespans = 0;
+		long n6_makespans = 0;
+		int runs = 0;
+		std::vector<vnd::MoveType> totals;
+		for (int i : instance_indices) {
+			vnd::Vnd descent(instances[i], m);
+			local_search::LocalSearch search(instances[i], m);
+			for (int start = 0; start < 10; ++start) {
+				jssp::Schedule schedule;
+				if (start == 0) {
+					schedule = jssp::generate_schedule_shortest_starting_time(instances[i], m);
+				} else {
+					std::vector<int> task_indices(j, 0);
+					while (schedule.size() < j * m) {
+						int job = engine() % j;
+						if (task_indices[job] < m)
+							schedule.push_back(instances[i][job][task_indices[job]++]);
+					}
+				}
+				auto copy = schedule;
+				vnd_makespans += descent.run(schedule);
+				n6_makespans += search.run(copy);
+				runs++;
+			}
+			if (totals.empty())
+				totals = descent.move_types;
+			else
+				for (auto [total, type] : std::ranges::views::zip(totals, descent.move_types)) {
+					total.estimates += type.estimates;
+					total.evaluations += type.evaluations;
+					total.improvements += type.improvements;
+					total.gain += type.gain;
+					total.time += type.time;
+				}
+		}
+		util::println("{}x{}: vnd {}, n6 {}", j, m, float(vnd_makespans) / runs, float(n6_makespans) / runs);
+		vnd::Vnd printer(instances[0], m);
+		printer.move_types = totals;
+		printer.print_statistics();
+		for (auto& type : totals) {
+			double seconds = util::seconds(type.time).count();
+			std::string line = util::format("{} {},{},{},{},{},{:.3f},{:.0f},{:.0f},{:.1f},{:.1f}\n", j, m, type.name, type.estimates, type.evaluations,
+				type.improvements, type.success_rate(), type.evaluations / seconds, type.gain / seconds, float(vnd_makespans) / runs, float(n6_makespans) / runs);
+			util::write(filename, line, std::ios::app);
+		}
+	};
+	std::vector instance_indices = {0, 1};
+	benchmark(20, 15, instance_indices);
+	benchmark(30, 15, instance_indices);
+	benchmark(50, 15, instance_indices);
+	benchmark(100, 20, instance_indices);
+}
+
+// iterations the pso needs to reach the final makespan of the plain pso, with and without the critical path bias,
+// on the same seeds. -1 when a run never reaches it
+void benchmark_critical_path_bias() {
+	std::string filename = "experiments/results/critical-path-bias.csv";
+	util::write(filename, "jobs machines,instance,seed,pso makespan,pso iterations,biased makespan,biased iterations\n", std::ios::out | std::ios::trunc);
+	int number_of_particles = 100;
+
+	// improvements of the gbest makespan with the iteration they happened in, the initial swarm being iteration 0
+	auto run = [&](jssp::Jobs& jobs, int m, int iterations, unsigned seed, bool bias) {
+		pso::Pso pso(jobs, m);
+		pso.random_engine.seed(seed);
+		pso.set_iterations(iterations);
+		pso.set_number_of_particles(number_of_particles);
+		pso.set_w(0.3f);
+		pso.set_c1(0.1f);
+		pso.set_c2(0.9f);
+		pso.set_critical_path_bias(bias);
+		std::vector<std::pair<int, long>> improvements;
+		pso.set_on_improvement([&](int makespan, long, util::milliseconds) {
+			improvements.push_back({makespan, pso.iteration});
+		});
+		pso.init_swarm();
+		pso.run();
+		return improvements;
+	};
+	auto iterations_to = [](const std::vector<std::pair<int, long>>& improvements, int target) {
+		auto reached = std::find_if(improvements.begin(), improvements.end(), [&](auto& improvement) { return improvement.first <= target; });
+		return reached == improvements.end() ? -1 : reached->second;
+	};
+	auto benchmark = [&](int j, int m, int iterations, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			for (unsigned seed = 0; seed < 4; ++seed) {
+				auto plain = run(instances[i], m, iterations, seed, false);
+				auto biased = run(instances[i], m, iterations, seed, true);
+				int target = plain.back().first;
+				std::string line = util::format("{} {},{},{},{},{},{},{}\n", j, m, i, seed, target, iterations_to(plain, target),
+					biased.back().first, iterations_to(biased, target));
+				util::print(line);
+				util::write(filename, line, std::ios::app);
+			}
+		}
+	};
+	benchmark(50, 15, 200, {0});
+	benchmark(100, 20, 100, {0});
+}
 
 /*
 // logs the makespan of the best solution found by pso2 for each set of parameters
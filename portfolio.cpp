@@ -0,0 +1,101 @@
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "parse.cpp"
+#include "util.cpp"
+#include "jssp.cpp"
+#include "pso2.cpp"
+#include "bnb.cpp"
+
+struct PortfolioResult {
+	int makespan;
+	jssp::Schedule schedule;
+	bool optimal; // the branch and bound searched its whole tree, nothing better than makespan exists
+	int pso_makespan;
+	DfsResult bnb;
+};
+
+// runs pso::Pso and the parallel branch and bound side by side, half of the threads each (at least one each), for at
+// most time_limit. they exchange schedules through a jssp::SharedIncumbent: every pso improvement tightens the bound
+// the branch and bound prunes with, and the schedules the branch and bound finds are brought into the swarm. once the
+// branch and bound has searched its whole tree the incumbent is optimal and the pso is cancelled
+PortfolioResult run_portfolio(jssp::Jobs& jobs, int number_of_machines, int number_of_threads, util::timer::duration_type time_limit) {
+	int pso_threads = std::max(1, number_of_threads / 2);
+	int bnb_threads = std::max(1, number_of_threads - pso_threads);
+	jssp::SharedIncumbent incumbent;
+	util::CancelToken cancel_token;
+
+	// parameters of the grid search of main.cpp, the time limit stops the run
+	pso::Pso pso(jobs, number_of_machines);
+	pso.set_iterations(std::numeric_limits<int>::max());
+	pso.set_number_of_particles(100);
+	pso.set_w(0.3f);
+	pso.set_c1(0.1f);
+	pso.set_c2(0.9f);
+	pso.set_delta(0);
+	pso.set_warm_start_fraction(0.1f);
+	pso.set_number_of_threads(pso_threads);
+	pso.set_time_limit(time_limit);
+	pso.set_cancel_token(&cancel_token);
+	pso.set_shared_incumbent(&incumbent);
+
+	util::SearchLimits bnb_limits;
+	bnb_limits.set_time_limit(time_limit);
+	bnb_limits.set_cancel_token(&cancel_token);
+	DfsOptions options;
+	options.limits = &bnb_limits;
+	options.shared_incumbent = &incumbent;
+
+	std::thread pso_thread([&] {
+		pso.init_swarm();
+		pso.run_parallal();
+	});
+	DfsResult bnb = dfs_optimized_parallel(jobs, number_of_machines, bnb_threads, options);
+	// the branch and bound only returns early when it proved the incumbent optimal, nothing is left for the pso to find
+	cancel_token.cancel();
+	pso_thread.join();
+
+	PortfolioResult result = {incumbent.get(), {}, incumbent.is_optimal(), pso.get_best_makespan(), std::move(bnb)};
+	if (auto best = incumbent.best())
+		result.schedule = best->schedule;
+	return result;
+}
+
+// runs the portfolio on the first instances of the benchmarks for one minute each
+void benchmark_portfolio() {
+	std::string filename = "experiments/results/portfolio-benchmark.csv";
+	int number_of_threads = std::thread::hardware_concurrency();
+	util::write(filename, "jobs machines,instance,makespan,optimal,pso makespan,bnb nodes\n", std::ios::out | std::ios::trunc);
+
+	auto benchmark = [&](int j, int m, std::vector<int> instance_indices) {
+		auto instances = load_jobs(util::format("experiments/benchmarks/tai{}_{}.txt", j, m));
+		for (int i : instance_indices) {
+			auto result = run_portfolio(instances[i], m, number_of_threads, util::minutes(1));
+			std::string line = util::format("{} {},{},{},{},{},{}\n", j, m, i, result.makespan, result.optimal, result.pso_makespan, result.bnb.stats.nodes);
+			util::print(line);
+			util::write(filename, line, std::ios::app);
+		}
+	};
+	benchmark(20, 15, {0, 1});
+	benchmark(30, 15, {0, 1});
+}
+
+void test_portfolio() {
+	int j = 8;
+	int m = 6;
+	jssp::Jobs jobs = jssp::generate_random_jobs(j, m);
+	auto result = run_portfolio(jobs, m, std::thread::hardware_concurrency(), util::seconds(10));
+	util::println("Best makespan: {} ({})", result.makespan, result.optimal ? "optimal" : "time limit");
+	util::println("PSO makespan: {}, branch and bound makespan: {}", result.pso_makespan, result.bnb.makespan);
+	result.bnb.stats.print();
+}
+
+
+
+int main() {
+
+	test_portfolio();
+
+	return 0;
+}
@@ -1,10 +1,19 @@
+#pragma once
 #include <vector>
 #include <random>
 #include <algorithm>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <numeric>
+#include <cstdint>
+#include <bit>
+#include <cmath>
 #include "util.cpp"
 #include "jssp.cpp"
+#include "local_search.cpp"
+#include "relinking.cpp"
+#include "archive.cpp"
 
 auto print_positions = [](const std::vector<float>& positions) {
 	util::print("Positions: ");
@@ -24,16 +33,250 @@ namespace pso {
 		Velocity velocity;
 		Position pbest_position;
 		int pbest_makespan;
+		// iterations since the last pbest improvement
+		int stagnation_count = 0;
+		// best pbest seen in the particle's neighborhood, unused with the global topology
+		Position lbest_position;
+		int lbest_makespan = std::numeric_limits<int>::max();
+		// keys of the operations on a critical path of the last decoded position, empty without the critical path bias
+		std::vector<char> critical;
 	};
 
+	// which particles a particle follows: global follows gbest, the others the best pbest of a neighborhood.
+	// neighborhoods are built over contiguous particle indices, which is also how particles are split between workers
+	enum class Topology {
+		global,
+		ring, // neighborhood_radius particles on each side
+		von_neumann, // up, down, left and right on a toroidal grid whose rows are runs of contiguous particles
+		random_dynamic, // random_informants random particles of the same worker plus one of any worker, re-drawn when gbest doesn't improve
+	};
+
+	// scratch buffers of the random-key decoder, each thread owns one so that evaluations don't allocate
+	struct Decoder {
+		std::vector<int> indices;
+		std::vector<int> operation_priorities;
+		std::vector<int> scheduled_ops;
+		std::vector<int> machine_available_time;
+		std::vector<int> job_available_time;
+		jssp::Schedule schedule;
+		jssp::LeftShiftBuffers left_shift;
+		// timing of the last decoded schedule, indexed by key (job * number_of_machines + index): the end of every
+		// operation and the operation whose end fixed its start, its job or machine predecessor (-1 if it starts at 0)
+		std::vector<int> end_times;
+		std::vector<int> start_predecessors;
+		std::vector<int> machine_last; // key of the last operation decoded on every machine
+		// evaluate_keys found the makespan in the cache: the ranks are the ones of the keys but the schedule and its
+		// timing come from an earlier decode
+		bool cache_hit = false;
+	};
+
+	// fixed-size lock-free cache from the hash of a decoded priority order to its makespan, shared by all the workers.
+	// a slot packs the upper 40 bits of the hash with a 24-bit makespan so that reads and writes are a single atomic,
+	// the slot index comes from the lower bits, and colliding entries simply overwrite each other
+	struct FitnessCache {
+		static constexpr uint64_t makespan_mask = (uint64_t(1) << 24) - 1;
+
+		std::vector<std::atomic<uint64_t>> slots;
+		uint64_t index_mask = 0;
+		std::atomic<long> hits = 0;
+		std::atomic<long> misses = 0;
+
+		// the size is rounded up to a power of two, 0 disables the cache
+		void resize(size_t size) {
+			size_t capacity = size == 0 ? 0 : std::bit_ceil(size);
+			slots = std::vector<std::atomic<uint64_t>>(capacity);
+			index_mask = capacity == 0 ? 0 : capacity - 1;
+			clear();
+		}
+		void clear() {
+			for (auto& slot : slots)
+				slot.store(0, std::memory_order_relaxed);
+			hits = 0;
+			misses = 0;
+		}
+		bool enabled() const {
+			return not slots.empty();
+		}
+
+		bool lookup(uint64_t hash, int& makespan) {
+			uint64_t entry = slots[hash & index_mask].load(std::memory_order_relaxed);
+			if (entry != 0 and (entry & ~makespan_mask) == (hash & ~makespan_mask)) {
+				hits.fetch_add(1, std::memory_order_relaxed);
+				makespan = entry & makespan_mask;
+				return true;
+			}
+			misses.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		void insert(uint64_t hash, int makespan) {
+			if (makespan <= 0 or uint64_t(makespan) > makespan_mask)
+				return;
+			slots[hash & index_mask].store((hash & ~makespan_mask) | uint64_t(makespan), std::memory_order_relaxed);
+		}
+
+		float hit_rate() const {
+			long total = hits + misses;
+			return total == 0 ? 0.f : float(hits) / total;
+		}
+	};
+
+	// 64-bit hash of an operation order (splitmix64 finalizer folded over the elements)
+	uint64_t hash_order(const std::vector<int>& order) {
+		uint64_t hash = 0x9e3779b97f4a7c15ull ^ order.size();
+		for (int value : order) {
+			hash ^= uint64_t(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+			hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+			hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+			hash ^= hash >> 31;
+		}
+		return hash;
+	}
+
+	// fills decoder.indices with the argsort of the keys and decoder.operation_priorities with their ranks
+	void rank_keys(const std::vector<float>& keys, Decoder& decoder) {
+		auto& indices = decoder.indices;
+		indices.resize(keys.size());
+		std::iota(indices.begin(), indices.end(), 0);
+		std::sort(indices.begin(), indices.end(), [&keys](int i1, int i2) {
+			return keys[i1] < keys[i2];
+		});
+		decoder.operation_priorities.resize(keys.size());
+		for (size_t i = 0; i < indices.size(); ++i)
+			decoder.operation_priorities[indices[i]] = i;
+	}
+
+	// builds the parameterized active schedule of decoder.operation_priorities into decoder.schedule and returns its makespan.
+	// shared by pso::Pso and brkga::Brkga, neither allocates once the buffers of its decoders have grown
+	int decode(const jssp::Jobs& jobs, int number_of_machines, float delta, Decoder& decoder) {
+		int job_count = jobs.size();
+		int total_operations = job_count * number_of_machines;
+		const auto& operation_priorities = decoder.operation_priorities;
+
+		auto& schedule = decoder.schedule;
+		auto& scheduled_ops = decoder.scheduled_ops; // Compteur d'opérations schedulées par job
+		auto& machine_available_time = decoder.machine_available_time;
+		auto& job_available_time = decoder.job_available_time;
+		schedule.clear();
+		scheduled_ops.assign(job_count, 0);
+		machine_available_time.assign(number_of_machines, 0);
+		job_available_time.assign(job_count, 0);
+		decoder.end_times.resize(total_operations);
+		decoder.start_predecessors.resize(total_operations);
+		decoder.machine_last.assign(number_of_machines, -1);
+
+		for (int t = 0; t < total_operations; ++t) {
+			// the schedulable operations are the next operation of every job that still has some
+			int sigma_star = std::numeric_limits<int>::max();
+			int phi_star = std::numeric_limits<int>::max();
+
+			for (int job_id = 0; job_id < job_count; ++job_id) {
+				if (scheduled_ops[job_id] == number_of_machines)
+					continue;
+				const auto& task = jobs[job_id][scheduled_ops[job_id]];
+				int start_time = std::max(job_available_time[job_id], machine_available_time[task.machine]);
+				int end_time = start_time + task.time;
+
+				if (start_time < sigma_star) sigma_star = start_time;
+				if (end_time < phi_star) phi_star = end_time;
+			}
+
+			int selected_job = -1;
+			int highest_priority = std::numeric_limits<int>::max();
+			int earliest_end_time = std::numeric_limits<int>::max();
+
+			for (int job_id = 0; job_id < job_count; ++job_id) {
+				if (scheduled_ops[job_id] == number_of_machines)
+					continue;
+				int op_index = scheduled_ops[job_id];
+				const auto& task = jobs[job_id][op_index];
+				int start_time = std::max(job_available_time[job_id], machine_available_time[task.machine]);
+				int end_time = start_time + task.time;
+
+				if (start_time <= sigma_star + delta * (phi_star - sigma_star)) {
+					int op_priority = operation_priorities[job_id * number_of_machines + op_index];
+
+					if (op_priority < highest_priority ||
+						(op_priority == highest_priority && end_time < earliest_end_time)) {
+						highest_priority = op_priority;
+						earliest_end_time = end_time;
+						selected_job = job_id;
+					}
+				}
+			}
+
+			if (selected_job != -1) {
+				const auto& task = jobs[selected_job][scheduled_ops[selected_job]];
+				int job_time = job_available_time[selected_job];
+				int machine_time = machine_available_time[task.machine];
+				int end_time = std::max(job_time, machine_time) + task.time;
+
+				int key = selected_job * number_of_machines + scheduled_ops[selected_job];
+				decoder.end_times[key] = end_time;
+				decoder.start_predecessors[key] = end_time == task.time ? -1 : job_time >= machine_time ? key - 1 : decoder.machine_last[task.machine];
+				decoder.machine_last[task.machine] = key;
+				machine_available_time[task.machine] = end_time;
+				job_available_time[selected_job] = end_time;
+				scheduled_ops[selected_job]++;
+
+				schedule.push_back(task);
+			}
+		}
+
+		return *std::max_element(job_available_time.begin(), job_available_time.end());
+	}
+
+	// makespan of the keys: ranked, then looked up in the cache when it is enabled and decoded otherwise. shared by
+	// pso::Pso and brkga::Brkga
+	int evaluate_keys(const jssp::Jobs& jobs, int number_of_machines, float delta, const std::vector<float>& keys,
+		Decoder& decoder, FitnessCache& cache) {
+		rank_keys(keys, decoder);
+		uint64_t hash = 0;
+		decoder.cache_hit = false;
+		if (cache.enabled()) {
+			// the sorted indices carry the same information as the ranks
+			hash = hash_order(decoder.indices);
+			int makespan;
+			if (cache.lookup(hash, makespan)) {
+				decoder.cache_hit = true;
+				return makespan;
+			}
+		}
+		int makespan = decode(jobs, number_of_machines, delta, decoder);
+		if (cache.enabled())
+			cache.insert(hash, makespan);
+		return makespan;
+	}
 	
-	struct Pso {
+	// marks the keys of the operations of a critical path of the last decoded schedule, walked back from the operation
+	// that ends last through the predecessors the decoder recorded
+	void mark_critical_keys(const Decoder& decoder, std::vector<char>& critical) {
+		auto& end_times = decoder.end_times;
+		critical.assign(end_times.size(), false);
+		if (end_times.empty())
+			return;
+		int key = std::max_element(end_times.begin(), end_times.end()) - end_times.begin();
+		for (; key != -1; key = decoder.start_predecessors[key])
+			critical[key] = true;
+	}
+
+	// which decoded schedules are left-shifted, see Pso::compact. with delta < 1 the decoder builds active schedules
+	// already and nothing is gained
+	enum class Compaction {
+		none,
+		pbests, // the evaluations that improve the pbest of their particle
+		evaluations, // every evaluation
+	};
+
+	// stop criteria, improvement callback and cancel token come from util::SearchLimits. the limits start with
+	// init_swarm, its evaluations and time count toward the budgets of the run that follows
+	struct Pso : util::SearchLimits {
 
 		jssp::Jobs& jobs;
 		int number_of_machines;
 		int number_of_tasks;
 		int iterations = 500;
 		int number_of_particles = 30;
+		int iteration = 0; // of the run in progress, from 1. init_swarm sets it to 0
 
 		float w = 0.2f; // inertia weight
 		float c1 = 1.f; // cognitive weight
@@ -42,10 +285,72 @@ namespace pso {
 
 		float delta = 0.5f;
 
+		int number_of_threads = 0; // workers of run_parallal, 0 means one per hardware thread
+		Topology topology = Topology::global;
+		int neighborhood_radius = 1;
+		int random_informants = 3;
+		std::vector<std::vector<int>> neighborhoods;
+		int neighborhood_gbest_makespan = std::numeric_limits<int>::max();
+
+		// restarts, all disabled by default
+		int stagnation_limit = 0; // iterations without pbest improvement before a particle is re-seeded
+		int swarm_stagnation_limit = 0; // iterations without gbest improvement before part of the swarm is re-seeded
+		float diversity_threshold = 0.f; // swarm diversity under which part of the swarm is re-seeded
+		float restart_fraction = 0.5f; // fraction of the swarm, worst pbest first, re-seeded by a swarm-level restart
+		float elite_restart_probability = 0.5f; // chance that a particle is re-seeded around an elite pbest instead of randomly
+		float restart_radius = 0.5f; // standard deviation of the noise added to the elite position
+		int swarm_stagnation_count = 0;
+		int last_gbest_makespan = std::numeric_limits<int>::max();
+		int restarts = 0; // number of re-seeded particles
+
+		// warm start: fraction of the swarm initialized from the dispatching rules and the seed schedules
+		float warm_start_fraction = 0.f;
+		float warm_start_noise = 0.05f; // standard deviation of the noise added to every copy of a seed after the first
+		std::vector<jssp::Schedule> seed_schedules;
+
+		// portfolio: gbest improvements are offered to the shared incumbent, and better schedules found by other
+		// solvers are brought into the swarm between iterations
+		jssp::SharedIncumbent* shared_incumbent = nullptr;
+		int imported_makespan = std::numeric_limits<int>::max();
+
+		// improved pbests and local search schedules are offered to the elite archive, and its schedules seed the warm
+		// start, the restarts around elites and the path relinking
+		archive::EliteArchive* elite_archive = nullptr;
+
+		// lamarckian left shift of the decoded schedules, with what it costs and what it gains over all the runs
+		Compaction compaction = Compaction::none;
+		std::atomic<long> compactions = 0;
+		std::atomic<long> compaction_gain = 0; // sum of the makespan reductions it brought to the positions
+		std::atomic<long> compaction_time = 0; // nanoseconds
+
+		// local search on the critical blocks of the schedules, see local_search::LocalSearch. the best schedule it
+		// found is kept as is, the decoder can't always rebuild it from its encoding
+		bool local_search = false; // the gbest schedule is improved at the end of a run
+		bool memetic = false; // every improved pbest too, and replaced by the encoding of the result when it decodes better
+		local_search::Neighborhood neighborhood = local_search::Neighborhood::n6;
+		jssp::Schedule local_search_schedule; // guarded by gbest_mutex
+		int local_search_makespan = std::numeric_limits<int>::max();
+		// at the end of a run, path relinking between the schedules of the best distinct pbests, see
+		// relinking::PathRelinking. its best schedule is kept like the ones of the local search
+		bool path_relinking = false;
+		int relinking_elites = 6;
+		// critical path bias: only the operations of a critical path can shorten the schedule, so the velocity of the
+		// keys of the other operations is scaled by noncritical_velocity and the keys of the critical ones get a random
+		// velocity of up to critical_perturbation on top of theirs, which moves them past their neighbors in the order
+		bool critical_path_bias = false;
+		float noncritical_velocity = 0.3f;
+		float critical_perturbation = 0.5f;
+
 		std::vector<Particle> swarm;		
 		Particle::Position gbest_position;
 		int gbest_makespan = std::numeric_limits<int>::max();
+		// guards gbest_position and gbest_makespan so the best solution can be read while a run is in progress
+		std::mutex gbest_mutex;
 
+		// makespans of already decoded priority orders, disabled until set_cache_size is called
+		FitnessCache cache;
+		// decoder used by the sequential code paths, parallel workers own their own
+		Decoder decoder;
 
 		std::mt19937 random_engine;
 		std::uniform_real_distribution<float> uniform_real_dist;	
@@ -72,10 +377,84 @@ namespace pso {
 		}
 		void set_delta(float d) {
 			this->delta = std::clamp(d, 0.f, 1.f);
+			// cached makespans were decoded with the previous delta
+			cache.clear();
+		}
+		void set_number_of_threads(int number_of_threads) {
+			this->number_of_threads = number_of_threads;
+		}
+		void set_topology(Topology topology) {
+			this->topology = topology;
+		}
+		void set_neighborhood_radius(int neighborhood_radius) {
+			this->neighborhood_radius = std::max(1, neighborhood_radius);
+		}
+		void set_random_informants(int random_informants) {
+			this->random_informants = std::max(1, random_informants);
+		}
+		void set_cache_size(size_t size) {
+			cache.resize(size);
+		}
+		void set_stagnation_limit(int stagnation_limit) {
+			this->stagnation_limit = stagnation_limit;
+		}
+		void set_swarm_stagnation_limit(int swarm_stagnation_limit) {
+			this->swarm_stagnation_limit = swarm_stagnation_limit;
+		}
+		void set_diversity_threshold(float diversity_threshold) {
+			this->diversity_threshold = diversity_threshold;
+		}
+		void set_restart_fraction(float restart_fraction) {
+			this->restart_fraction = std::clamp(restart_fraction, 0.f, 1.f);
+		}
+		void set_elite_restart_probability(float elite_restart_probability) {
+			this->elite_restart_probability = std::clamp(elite_restart_probability, 0.f, 1.f);
+		}
+		void set_restart_radius(float restart_radius) {
+			this->restart_radius = restart_radius;
+		}
+		void set_warm_start_fraction(float warm_start_fraction) {
+			this->warm_start_fraction = std::clamp(warm_start_fraction, 0.f, 1.f);
+		}
+		void set_warm_start_noise(float warm_start_noise) {
+			this->warm_start_noise = warm_start_noise;
+		}
+		// schedules from earlier runs or other solvers, used by init_swarm when warm_start_fraction > 0
+		void add_seed_schedule(const jssp::Schedule& schedule) {
+			seed_schedules.push_back(schedule);
+		}
+		void set_shared_incumbent(jssp::SharedIncumbent* shared_incumbent) {
+			this->shared_incumbent = shared_incumbent;
+		}
+		void set_compaction(Compaction compaction) {
+			this->compaction = compaction;
+		}
+		void set_elite_archive(archive::EliteArchive* elite_archive) {
+			this->elite_archive = elite_archive;
+		}
+		void set_local_search(bool local_search) {
+			this->local_search = local_search;
+		}
+		void set_memetic(bool memetic) {
+			this->memetic = memetic;
+		}
+		void set_path_relinking(bool path_relinking, int relinking_elites = 6) {
+			this->path_relinking = path_relinking;
+			this->relinking_elites = relinking_elites;
+		}
+		void set_neighborhood(local_search::Neighborhood neighborhood) {
+			this->neighborhood = neighborhood;
+		}
+		void set_critical_path_bias(bool critical_path_bias, float noncritical_velocity = 0.3f, float critical_perturbation = 0.5f) {
+			this->critical_path_bias = critical_path_bias;
+			this->noncritical_velocity = std::clamp(noncritical_velocity, 0.f, 1.f);
+			this->critical_perturbation = std::max(0.f, critical_perturbation);
 		}
 
 
 		void init_swarm() {
+			start_limits();
+			iteration = 0;
 			auto init_positions = [&](int size) {
 				std::vector<float> positions(size);
 				for (int i = 0; i < size; ++i) 
@@ -83,177 +462,477 @@ namespace pso {
 				return positions;
 			};
 
+			// the first particles are copies of the seeds, all copies after the first one of a seed are perturbed
+			std::vector<Particle::Position> seeds;
+			int seeded = std::round(warm_start_fraction * number_of_particles);
+			if (seeded > 0) {
+				seeds.push_back(encode_schedule(jssp::generate_schedule_shortest_starting_time(jobs, number_of_machines)));
+				seeds.push_back(encode_schedule(jssp::generate_schedule_shortest_finishing_time(jobs, number_of_machines)));
+				for (auto& schedule : seed_schedules)
+					seeds.push_back(encode_schedule(schedule));
+				if (elite_archive != nullptr)
+					for (auto& entry : elite_archive->get_entries())
+						seeds.push_back(encode_schedule(entry->schedule));
+			}
+			std::normal_distribution<float> noise(0.f, warm_start_noise);
+
 			swarm.resize(number_of_particles);
-			for (auto& p : swarm) {
-				p.position = init_positions(number_of_tasks);
+			for (int i = 0; i < number_of_particles; ++i) {
+				auto& p = swarm[i];
+				if (i < seeded) {
+					p.position = seeds[i % seeds.size()];
+					if (i >= seeds.size())
+						for (auto& x : p.position)
+							x += noise(random_engine);
+				} else {
+					p.position = init_positions(number_of_tasks);
+				}
 				p.velocity = init_positions(number_of_tasks);
 				p.pbest_position = p.position;
 				p.pbest_makespan = fitness(p.position);
-				if (p.pbest_makespan < gbest_makespan) {
-					gbest_position = p.position;
-					gbest_makespan = p.pbest_makespan;
-				}
+				update_critical(p, decoder);
+				p.lbest_makespan = std::numeric_limits<int>::max();
+				offer_to_archive(p.position, p.pbest_makespan);
+				offer_gbest(p.position, p.pbest_makespan);
 			}
+			build_neighborhoods();
+			update_neighborhood_bests();
 
 			// util::println("Best makespan: {}", gbest_makespan);
 			// util::print("Best position: ");
 		}
 
+		// inverse of the decoder: keys spread over the initialization range in the order in which the tasks of the
+		// schedule start. the decoder gives the schedule back whenever it is one it can build with the current delta
+		// (with delta = 0 any non-delay schedule, like the dispatching rules), otherwise the closest one it can build
+		Particle::Position encode_schedule(const jssp::Schedule& schedule) {
+			auto start_times = jssp::start_times_schedule(schedule, jobs.size(), number_of_machines);
+			std::vector<int> order(schedule.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+				return start_times[a] < start_times[b];
+			});
+
+			float lower = uniform_real_dist.a();
+			float step = (uniform_real_dist.b() - lower) / number_of_tasks;
+			Particle::Position position(number_of_tasks);
+			for (int rank = 0; rank < order.size(); ++rank) {
+				auto& task = schedule[order[rank]];
+				position[task.job * number_of_machines + task.index] = lower + step * (rank + 0.5f);
+			}
+			return position;
+		}
+
 		int fitness(Particle::Position& position) {
-			jssp::Schedule schedule = generate_schedule_from_positions(position);
-			int makespan = jssp::makespan_schedule(schedule, jobs.size(), number_of_machines);
-			return makespan;
+			return fitness(position, decoder);
 		}
 
-		jssp::Schedule generate_schedule_from_positions(const Particle::Position& position) {
-            auto indices = util::argsort(position);
-            std::vector<int> operation_priorities(position.size());
-            
-            // int job_count = jobs.size();
-            for (size_t i = 0; i < indices.size(); ++i) {
-                operation_priorities[indices[i]] = i; 
-            }
+		int fitness(const Particle::Position& position, Decoder& decoder) {
+			count_evaluation();
+			return evaluate_keys(jobs, number_of_machines, delta, position, decoder, cache);
+		}
 
-            return build_parameterized_active_schedule(operation_priorities);
-        }
+		void rank_positions(const Particle::Position& position, Decoder& decoder) {
+			rank_keys(position, decoder);
+		}
+
+		jssp::Schedule generate_schedule_from_positions(const Particle::Position& position) {
+			Decoder decoder;
+			rank_positions(position, decoder);
+			decode(decoder);
+			return decoder.schedule;
+		}
 
 		jssp::Schedule build_parameterized_active_schedule(const std::vector<int>& operation_priorities) {
-            int job_count = jobs.size();
-            int total_operations = job_count * number_of_machines;
-            
-            jssp::Schedule schedule;
-            std::vector<int> scheduled_ops(job_count, 0); // Compteur d'opérations schedulées par job
-            std::vector<int> machine_available_time(number_of_machines, 0);
-            std::vector<int> job_available_time(job_count, 0);
-
-            for (int t = 0; t < total_operations; ++t) {
-                std::vector<std::tuple<int, int>> schedulable_ops; 
-                for (int job_id = 0; job_id < job_count; ++job_id) {
-					// if the job still has operations to schedule, add it to the list of schedulable operations
-                    if (scheduled_ops[job_id] < number_of_machines) {
-                        schedulable_ops.emplace_back(job_id, scheduled_ops[job_id]);
-                    }
-                }
-
-                int sigma_star = std::numeric_limits<int>::max();
-                int phi_star = std::numeric_limits<int>::max();
-                
-                for (const auto& [job_id, op_index] : schedulable_ops) {
-                    const auto& task = jobs[job_id][op_index];
-                    int machine = task.machine;
-                    int start_time = std::max(job_available_time[job_id], machine_available_time[machine]);
-                    int end_time = start_time + task.time;
-                    
-                    if (start_time < sigma_star) sigma_star = start_time;
-                    if (end_time < phi_star) phi_star = end_time;
-                }
-
-                int selected_job = -1;
-                int selected_op_index = -1;
-                int highest_priority = std::numeric_limits<int>::max();
-                int earliest_end_time = std::numeric_limits<int>::max();
-
-                for (const auto& [job_id, op_index] : schedulable_ops) {
-                    const auto& task = jobs[job_id][op_index];
-                    int machine = task.machine;
-                    int start_time = std::max(job_available_time[job_id], machine_available_time[machine]);
-                    int end_time = start_time + task.time;
-                    
-                    if (start_time <= sigma_star + delta * (phi_star - sigma_star)) {
-                        int op_priority = operation_priorities[job_id * number_of_machines + op_index];
-                        
-                        if (op_priority < highest_priority || 
-                            (op_priority == highest_priority && end_time < earliest_end_time)) {
-                            highest_priority = op_priority;
-                            earliest_end_time = end_time;
-                            selected_job = job_id;
-                            selected_op_index = op_index;
-                        }
-                    }
-                }
-
-                if (selected_job != -1) {
-                    const auto& task = jobs[selected_job][selected_op_index];
-                    int machine = task.machine;
-                    int start_time = std::max(job_available_time[selected_job], machine_available_time[machine]);
-                    int end_time = start_time + task.time;
-                    
-                    machine_available_time[machine] = end_time;
-                    job_available_time[selected_job] = end_time;
-                    scheduled_ops[selected_job]++;
-                    
-                    schedule.push_back(jobs[selected_job][selected_op_index]);
-                }
-            }
-
-            return schedule;
-        }
+			Decoder decoder;
+			decoder.operation_priorities = operation_priorities;
+			decode(decoder);
+			return decoder.schedule;
+		}
+
+		int decode(Decoder& decoder) {
+			return pso::decode(jobs, number_of_machines, delta, decoder);
+		}
+
+		int number_of_workers() {
+			int workers = number_of_threads > 0 ? number_of_threads : std::thread::hardware_concurrency();
+			return std::clamp(workers, 1, number_of_particles);
+		}
+		// first particle of the worker's contiguous partition
+		int partition_begin(int worker) {
+			return worker * number_of_particles / number_of_workers();
+		}
+
+		void build_neighborhoods() {
+			int size = swarm.size();
+			neighborhoods.assign(size, {});
+			switch (topology) {
+			case Topology::global:
+				break;
+			case Topology::ring:
+				for (int i = 0; i < size; ++i) {
+					neighborhoods[i].push_back(i);
+					for (int r = 1; r <= neighborhood_radius; ++r) {
+						neighborhoods[i].push_back((i - r + size) % size);
+						neighborhoods[i].push_back((i + r) % size);
+					}
+				}
+				break;
+			case Topology::von_neumann: {
+				int columns = std::ceil(std::sqrt(float(size)));
+				int rows = (size + columns - 1) / columns;
+				for (int i = 0; i < size; ++i) {
+					int row = i / columns, column = i % columns;
+					auto add = [&](int r, int c) {
+						int neighbor = (r + rows) % rows * columns + (c + columns) % columns;
+						// the last row may be incomplete
+						if (neighbor < size)
+							neighborhoods[i].push_back(neighbor);
+					};
+					add(row, column);
+					add(row - 1, column);
+					add(row + 1, column);
+					add(row, column - 1);
+					add(row, column + 1);
+				}
+				break;
+			}
+			case Topology::random_dynamic: {
+				int workers = number_of_workers();
+				std::uniform_int_distribution<int> anyone(0, size - 1);
+				for (int worker = 0; worker < workers; ++worker) {
+					int begin = partition_begin(worker), end = partition_begin(worker + 1);
+					std::uniform_int_distribution<int> same_worker(begin, end - 1);
+					for (int i = begin; i < end; ++i) {
+						neighborhoods[i].push_back(i);
+						for (int k = 0; k < random_informants; ++k)
+							neighborhoods[i].push_back(same_worker(random_engine));
+						neighborhoods[i].push_back(anyone(random_engine));
+					}
+				}
+				break;
+			}
+			}
+		}
+
+		// called between iterations: copies into every particle the best pbest of its neighborhood when it beats its lbest,
+		// so that during an iteration a particle only reads its own data instead of the shared gbest_position
+		void update_neighborhood_bests() {
+			if (topology == Topology::global)
+				return;
+			if (topology == Topology::random_dynamic) {
+				if (gbest_makespan >= neighborhood_gbest_makespan)
+					build_neighborhoods();
+				neighborhood_gbest_makespan = gbest_makespan;
+			}
+			for (int i = 0; i < swarm.size(); ++i) {
+				auto& p = swarm[i];
+				int best = i;
+				for (int neighbor : neighborhoods[i])
+					if (swarm[neighbor].pbest_makespan < swarm[best].pbest_makespan)
+						best = neighbor;
+				if (swarm[best].pbest_makespan < p.lbest_makespan) {
+					p.lbest_position = swarm[best].pbest_position;
+					p.lbest_makespan = swarm[best].pbest_makespan;
+				}
+			}
+		}
+
+		// gbest is the position the global topology follows: gbest_position itself in the sequential run, a copy the worker
+		// took under gbest_mutex at the start of the iteration in the parallel one
+		void move_particle(Particle& p, const Particle::Position& gbest, std::mt19937& engine) {
+			const auto& social_position = topology == Topology::global ? gbest : p.lbest_position;
+			float r1 = uniform_real_dist(engine);
+			float r2 = uniform_real_dist(engine);
+			bool focused = critical_path_bias and p.critical.size() == p.position.size();
+			std::uniform_real_distribution<float> perturbation(0.f, critical_perturbation);
+			for (size_t i = 0; i < p.position.size(); ++i) {
+				p.velocity[i] = w * p.velocity[i] + c1 * r1 * (p.pbest_position[i] - p.position[i]) + c2 * r2 * (social_position[i] - p.position[i]);
+				p.velocity[i] = std::clamp(p.velocity[i], 0.f, max_velocity);
+				if (focused)
+					p.velocity[i] = p.critical[i] ? p.velocity[i] + perturbation(engine) : p.velocity[i] * noncritical_velocity;
+				p.position[i] += p.velocity[i];
+			}
+		}
+
+		void update_pbest(Particle& p, int makespan) {
+			if (makespan < p.pbest_makespan) {
+				p.pbest_position = p.position;
+				p.pbest_makespan = makespan;
+				p.stagnation_count = 0;
+				offer_to_archive(p.position, makespan);
+			} else {
+				p.stagnation_count++;
+			}
+		}
+
+		// the schedule is only decoded again when the archive may take it
+		void offer_to_archive(const Particle::Position& position, int makespan) {
+			if (elite_archive != nullptr and elite_archive->accepts(makespan))
+				elite_archive->offer(makespan, generate_schedule_from_positions(position));
+		}
+
+		// updates the global best if makespan improves it, the caller must hold gbest_mutex. returns true if makespan is
+		// the new best solution, the caller reports it once it released gbest_mutex: the improvement callback may read
+		// the best solution
+		bool update_gbest(const Particle::Position& position, int makespan) {
+			if (makespan >= gbest_makespan)
+				return false;
+			gbest_position = position;
+			gbest_makespan = makespan;
+			if (shared_incumbent != nullptr and makespan < shared_incumbent->get())
+				shared_incumbent->offer(makespan, generate_schedule_from_positions(position));
+			return makespan < local_search_makespan;
+		}
+		void offer_gbest(const Particle::Position& position, int makespan) {
+			bool improved;
+			{
+				std::lock_guard lock(gbest_mutex);
+				improved = update_gbest(position, makespan);
+			}
+			if (improved)
+				report_improvement(makespan);
+		}
+
+		// keeps the schedule if it beats everything found so far, the caller must hold gbest_mutex. returns true if it
+		// was kept, the caller reports it like for update_gbest
+		bool update_local_search_schedule(const jssp::Schedule& schedule, int makespan) {
+			if (makespan >= local_search_makespan or makespan >= gbest_makespan)
+				return false;
+			local_search_schedule = schedule;
+			local_search_makespan = makespan;
+			if (elite_archive != nullptr)
+				elite_archive->offer(makespan, schedule);
+			if (shared_incumbent != nullptr and makespan < shared_incumbent->get())
+				shared_incumbent->offer(makespan, schedule);
+			return true;
+		}
+		void offer_local_search_schedule(const jssp::Schedule& schedule, int makespan) {
+			bool improved;
+			{
+				std::lock_guard lock(gbest_mutex);
+				improved = update_local_search_schedule(schedule, makespan);
+			}
+			if (improved)
+				report_improvement(makespan);
+		}
+
+		// memetic step after the pbest of the particle improved: the local search runs on its schedule, the encoding of
+		// the result becomes the particle's position and pbest when the decoder rebuilds something better from it
+		void improve_pbest(Particle& p, local_search::LocalSearch& search, Decoder& decoder) {
+			rank_positions(p.pbest_position, decoder);
+			decode(decoder);
+			jssp::Schedule schedule = decoder.schedule;
+			int makespan = search.run(schedule);
+			if (elite_archive != nullptr)
+				elite_archive->offer(makespan, schedule);
+			if (makespan >= p.pbest_makespan)
+				return;
+			auto position = encode_schedule(schedule);
+			int decoded_makespan = fitness(position, decoder);
+			int improvement = std::numeric_limits<int>::max();
+			{
+				std::lock_guard lock(gbest_mutex);
+				if (decoded_makespan < p.pbest_makespan) {
+					p.position = position;
+					p.pbest_position = std::move(position);
+					p.pbest_makespan = decoded_makespan;
+					if (update_gbest(p.pbest_position, decoded_makespan))
+						improvement = decoded_makespan;
+				}
+				if (update_local_search_schedule(schedule, makespan))
+					improvement = std::min(improvement, makespan);
+			}
+			if (improvement < std::numeric_limits<int>::max())
+				report_improvement(improvement);
+		}
+
+		// end of a run: the local search improves the gbest schedule
+		void improve_gbest() {
+			if (not local_search or gbest_position.empty())
+				return;
+			local_search::LocalSearch search(jobs, number_of_machines);
+			search.set_neighborhood(neighborhood);
+			auto schedule = generate_schedule_from_positions(gbest_position);
+			int makespan = search.run(schedule);
+			offer_local_search_schedule(schedule, makespan);
+		}
+
+		// end of a run: path relinking between the schedules of the elite archive, the best schedule of the local search
+		// and the schedules of the pbests, best first, as long as they have different machine sequences. it gets what is
+		// left of the budgets of the run
+		void relink_pbests() {
+			if (not path_relinking or swarm.empty() or should_stop())
+				return;
+			relinking::PathRelinking relinking(jobs, number_of_machines);
+			relinking.set_neighborhood(neighborhood);
+			relinking.set_number_of_threads(number_of_threads);
+			relinking.set_cancel_token(cancel_token);
+			if (use_time_limit)
+				relinking.set_time_limit(time_limit.left());
+			if (max_evaluations > 0)
+				relinking.set_max_evaluations(max_evaluations - evaluations.load(std::memory_order_relaxed));
+			if (elite_archive != nullptr)
+				for (auto& entry : elite_archive->get_entries())
+					if (relinking.elites.size() < relinking_elites)
+						relinking.add_elite(entry->schedule);
+			if (not local_search_schedule.empty())
+				relinking.add_elite(local_search_schedule);
+			std::vector<int> order(swarm.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&](int a, int b) {
+				return swarm[a].pbest_makespan < swarm[b].pbest_makespan;
+			});
+			for (int i = 0; i < order.size() and relinking.elites.size() < relinking_elites; ++i)
+				if (not swarm[order[i]].pbest_position.empty() and swarm[order[i]].pbest_makespan < std::numeric_limits<int>::max())
+					relinking.add_elite(generate_schedule_from_positions(swarm[order[i]].pbest_position));
+			auto schedule = relinking.run();
+			if (schedule.empty())
+				return;
+			offer_local_search_schedule(schedule, relinking.best_makespan);
+		}
+
+		// critical path bias: marks the critical operations of the schedule the particle's position was just decoded into
+		void update_critical(Particle& p, Decoder& decoder) {
+			if (not critical_path_bias)
+				return;
+			// a cache hit doesn't decode, the timing is the one of an earlier evaluation
+			if (decoder.cache_hit) {
+				decode(decoder);
+				decoder.cache_hit = false;
+			}
+			mark_critical_keys(decoder, p.critical);
+		}
+
+		// lamarckian left shift of the schedule the particle's position was just decoded into, see
+		// jssp::left_shift_schedule: when it gets shorter, its encoding replaces the position if the decoder builds
+		// something shorter from it. returns the makespan of the position
+		int compact(Particle& p, Decoder& decoder, int makespan) {
+			util::stopwatch sw;
+			// a cache hit doesn't decode, the schedule is the one of an earlier evaluation
+			if (decoder.cache_hit) {
+				decode(decoder);
+				decoder.cache_hit = false;
+			}
+			int result = makespan;
+			if (jssp::left_shift_schedule(decoder.schedule, jobs.size(), number_of_machines, decoder.left_shift) < makespan) {
+				auto position = encode_schedule(decoder.schedule);
+				int decoded_makespan = fitness(position, decoder);
+				if (decoded_makespan < makespan) {
+					p.position = std::move(position);
+					result = decoded_makespan;
+				} else {
+					// the decoder is left with the ranks of the position, its schedule is the one of the rejected
+					// encoding like after a cache hit
+					rank_positions(p.position, decoder);
+					decoder.cache_hit = true;
+				}
+			}
+			compactions.fetch_add(1, std::memory_order_relaxed);
+			compaction_gain.fetch_add(makespan - result, std::memory_order_relaxed);
+			compaction_time.fetch_add(sw.elapsed().count(), std::memory_order_relaxed);
+			return result;
+		}
+		bool should_compact(const Particle& p, int makespan) const {
+			return compaction == Compaction::evaluations or (compaction == Compaction::pbests and makespan < p.pbest_makespan);
+		}
+
+		// called between iterations: when another solver shared a better schedule than gbest, the particle with the
+		// worst pbest is moved onto its encoding. a schedule the decoder can't rebuild is only imported once
+		void import_shared_incumbent() {
+			if (shared_incumbent == nullptr or swarm.empty())
+				return;
+			int shared_makespan = shared_incumbent->get();
+			if (shared_makespan >= gbest_makespan or shared_makespan >= imported_makespan)
+				return;
+			auto best = shared_incumbent->best();
+			if (best == nullptr)
+				return;
+			imported_makespan = best->makespan;
+			auto& p = *std::max_element(swarm.begin(), swarm.end(), [](const Particle& a, const Particle& b) {
+				return a.pbest_makespan < b.pbest_makespan;
+			});
+			p.position = encode_schedule(best->schedule);
+			p.pbest_position = p.position;
+			p.pbest_makespan = fitness(p.position);
+			p.stagnation_count = 0;
+			offer_gbest(p.position, p.pbest_makespan);
+		}
 
 		void run() {
-			for (int iter = 0; iter < iterations; ++iter) {
+			local_search::LocalSearch search(jobs, number_of_machines);
+			search.set_neighborhood(neighborhood);
+			for (iteration = 1; iteration <= iterations and not should_stop(); ++iteration) {
 				for (auto& p : swarm) {
+					if (should_stop())
+						break;
 
-					float r1 = uniform_real_dist(random_engine);
-					float r2 = uniform_real_dist(random_engine);
-					for (size_t i = 0; i < p.position.size(); ++i) {
-						p.velocity[i] = w * p.velocity[i] + c1 * r1 * (p.pbest_position[i] - p.position[i]) + c2 * r2 * (gbest_position[i] - p.position[i]);
-						p.velocity[i] = std::clamp(p.velocity[i], 0.f, max_velocity);
-						p.position[i] += p.velocity[i];
-					}
+					move_particle(p, gbest_position, random_engine);
 					int makespan = fitness(p.position);
-					if (makespan < p.pbest_makespan) {
-						p.pbest_position = p.position;
-						p.pbest_makespan = makespan;
-					}
-					// mutex.lock();
-					if (makespan < gbest_makespan) {
-						gbest_position = p.position;
-						gbest_makespan = makespan;
-					}
+					if (should_compact(p, makespan))
+						makespan = compact(p, decoder, makespan);
+					update_critical(p, decoder);
+					update_pbest(p, makespan);
+					offer_gbest(p.position, makespan);
+					if (memetic and p.stagnation_count == 0)
+						improve_pbest(p, search, decoder);
 				}
+				import_shared_incumbent();
+				restart_stagnant_particles();
+				update_neighborhood_bests();
 			}
+			improve_gbest();
+			relink_pbests();
 		}
 
+		// every worker owns a contiguous partition of the swarm and moves its particles each iteration
 		void run_parallal() {
-			std::vector<util::ThreadSleeper> threads(number_of_particles);
+			int workers = number_of_workers();
+			std::vector<util::ThreadSleeper> threads(workers);
 			std::vector<std::thread> thread_pool;
 			util::ThreadSleeper main_thread;
 			
-			std::mutex gbest_mutex;
-			int left_threads = number_of_particles;
+			int left_threads = workers;
 
 			std::mutex stop_mutex;
 			bool stop = false;	
 
-			for (int i = 0; i < number_of_particles; i++) {
-				thread_pool.emplace_back(([&, i] {
+			for (int t = 0; t < workers; t++) {
+				int begin = partition_begin(t), end = partition_begin(t + 1);
+				thread_pool.emplace_back(([&, t, begin, end, seed = random_engine()] {
+					Decoder decoder;
+					local_search::LocalSearch search(jobs, number_of_machines);
+					search.set_neighborhood(neighborhood);
+					std::mt19937 engine(seed);
+					Particle::Position gbest;
 					while (true) {
-						threads[i].sleep_forever();
+						threads[t].sleep_forever();
 						stop_mutex.lock();
 						if (stop) {
 							stop_mutex.unlock();
 							return;
 						}
 						stop_mutex.unlock();
-
-						Particle& p = swarm[i];
-						float r1 = uniform_real_dist(random_engine);
-						float r2 = uniform_real_dist(random_engine);
-						for (size_t i = 0; i < p.position.size(); ++i) {
-							p.velocity[i] = w * p.velocity[i] + c1 * r1 * (p.pbest_position[i] - p.position[i]) + c2 * r2 * (gbest_position[i] - p.position[i]);
-							p.velocity[i] = std::clamp(p.velocity[i], 0.f, max_velocity);
-							p.position[i] += p.velocity[i];
+						// the other workers update gbest_position during the iteration
+						if (topology == Topology::global) {
+							std::lock_guard lock(gbest_mutex);
+							gbest = gbest_position;
 						}
-						int makespan = fitness(p.position);
-						if (makespan < p.pbest_makespan) {
-							p.pbest_position = p.position;
-							p.pbest_makespan = makespan;
+
+						// once a budget is spent the remaining particles of the iteration are skipped
+						for (int i = begin; i < end and not should_stop(); ++i) {
+							Particle& p = swarm[i];
+							move_particle(p, gbest, engine);
+							int makespan = fitness(p.position, decoder);
+							if (should_compact(p, makespan))
+								makespan = compact(p, decoder, makespan);
+							update_critical(p, decoder);
+							update_pbest(p, makespan);
+							offer_gbest(p.position, makespan);
+							if (memetic and p.stagnation_count == 0)
+								improve_pbest(p, search, decoder);
 						}
 						gbest_mutex.lock();
-						if (makespan < gbest_makespan) {
-							gbest_position = p.position;
-							gbest_makespan = makespan;
-						}
 						left_threads--;
 						if (left_threads == 0) 
 							main_thread.wake_thread();
@@ -263,23 +942,136 @@ namespace pso {
 				}));
 			}
 
-			for (int iter = 0; iter < iterations; ++iter) {
+			for (iteration = 1; iteration <= iterations and not should_stop(); ++iteration) {
 				for (auto& thread : threads)
 					thread.wake_thread();
 				main_thread.sleep_forever();
-				left_threads = number_of_particles;
-				// util::println("Iteration {}: Best makespan: {}", iter, gbest_makespan);
+				left_threads = workers;
+				// the workers are all asleep here so the swarm can be modified without locking
+				import_shared_incumbent();
+				restart_stagnant_particles();
+				update_neighborhood_bests();
+				// util::println("Iteration {}: Best makespan: {}", iteration, gbest_makespan);
 			}
 			stop = true;
 			for (auto [thread_sleeper, thread] : std::ranges::views::zip(threads, thread_pool)) {
 				thread_sleeper.wake_thread(); 
 				thread.join(); 
 			}
+			improve_gbest();
+			relink_pbests();
+
+		}
 
+		// mean distance of the particles to the swarm centroid. positions are first rescaled to [0, 1] per particle,
+		// the decoder only looks at the order of the keys, and the result is normalized by sqrt(number_of_tasks)
+		float swarm_diversity() {
+			std::vector<float> centroid(number_of_tasks, 0.f);
+			std::vector<Particle::Position> normalized(swarm.size());
+			for (auto [p, position] : std::ranges::views::zip(swarm, normalized)) {
+				auto [min, max] = std::minmax_element(p.position.begin(), p.position.end());
+				float range = std::max(*max - *min, std::numeric_limits<float>::epsilon());
+				position.resize(number_of_tasks);
+				for (int i = 0; i < number_of_tasks; ++i) {
+					position[i] = (p.position[i] - *min) / range;
+					centroid[i] += position[i] / swarm.size();
+				}
+			}
+			float diversity = 0.f;
+			for (auto& position : normalized) {
+				float distance = 0.f;
+				for (int i = 0; i < number_of_tasks; ++i)
+					distance += (position[i] - centroid[i]) * (position[i] - centroid[i]);
+				diversity += std::sqrt(distance);
+			}
+			return diversity / swarm.size() / std::sqrt(float(number_of_tasks));
 		}
 
+		// moves the particle around one of the elite pbests or to a random position and forgets its pbest
+		void reseed_particle(Particle& p, const std::vector<Particle::Position>& elites) {
+			std::bernoulli_distribution use_elite(elite_restart_probability);
+			if (not elites.empty() and use_elite(random_engine)) {
+				std::uniform_int_distribution<int> pick(0, elites.size() - 1);
+				std::normal_distribution<float> noise(0.f, restart_radius);
+				const auto& elite = elites[pick(random_engine)];
+				for (int i = 0; i < number_of_tasks; ++i)
+					p.position[i] = elite[i] + noise(random_engine);
+			} else {
+				for (auto& x : p.position)
+					x = uniform_real_dist(random_engine);
+			}
+			for (auto& v : p.velocity)
+				v = uniform_real_dist(random_engine);
+			// the next evaluation becomes the new pbest
+			p.pbest_position = p.position;
+			p.pbest_makespan = std::numeric_limits<int>::max();
+			p.stagnation_count = 0;
+			restarts++;
+		}
+
+		// called between iterations: re-seeds the particles whose pbest stagnated and, when gbest stagnated or the swarm
+		// lost its diversity, the worst restart_fraction of the swarm. the particle holding gbest is never re-seeded
+		void restart_stagnant_particles() {
+			if (stagnation_limit <= 0 and swarm_stagnation_limit <= 0 and diversity_threshold <= 0.f)
+				return;
+
+			swarm_stagnation_count = gbest_makespan < last_gbest_makespan ? 0 : swarm_stagnation_count + 1;
+			last_gbest_makespan = gbest_makespan;
+
+			bool swarm_restart = (swarm_stagnation_limit > 0 and swarm_stagnation_count >= swarm_stagnation_limit) or
+				(diversity_threshold > 0.f and swarm_diversity() < diversity_threshold);
+			bool stagnant_particles = stagnation_limit > 0 and std::any_of(swarm.begin(), swarm.end(), [&](const Particle& p) {
+				return p.stagnation_count >= stagnation_limit;
+			});
+			if (not swarm_restart and not stagnant_particles)
+				return;
+
+			std::vector<int> order(swarm.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&](int a, int b) {
+				return swarm[a].pbest_makespan < swarm[b].pbest_makespan;
+			});
+			// copied since the particles they come from may be re-seeded too. the schedules of the elite archive are
+			// elites as well, they may come from earlier runs or other solvers
+			std::vector<Particle::Position> elites;
+			for (int i = 0; i < std::max<size_t>(1, swarm.size() / 10); ++i)
+				elites.push_back(swarm[order[i]].pbest_position);
+			if (elite_archive != nullptr)
+				for (auto& entry : elite_archive->get_entries())
+					elites.push_back(encode_schedule(entry->schedule));
+			int best = order.front();
+
+			if (swarm_restart) {
+				int count = restart_fraction * swarm.size();
+				for (int i = swarm.size() - count; i < swarm.size(); ++i)
+					if (order[i] != best)
+						reseed_particle(swarm[order[i]], elites);
+				swarm_stagnation_count = 0;
+			}
+			if (stagnation_limit > 0) {
+				for (int i = 0; i < swarm.size(); ++i)
+					if (i != best and swarm[i].stagnation_count >= stagnation_limit)
+						reseed_particle(swarm[i], elites);
+			}
+		}
+
+		int get_best_makespan() {
+			std::lock_guard lock(gbest_mutex);
+			return std::min(gbest_makespan, local_search_makespan);
+		}
+
+		// safe to call from another thread while run or run_parallal is in progress
 		jssp::Schedule get_best_schedule() {
-			auto schedule = generate_schedule_from_positions(gbest_position);
+			Particle::Position position;
+			{
+				std::lock_guard lock(gbest_mutex);
+				if (local_search_makespan < gbest_makespan)
+					return local_search_schedule;
+				position = gbest_position;
+			}
+			if (position.empty())
+				return {};
+			auto schedule = generate_schedule_from_positions(position);
 			jssp::sort_schedule(schedule, jobs.size(), number_of_machines);
 			return schedule;
 		}
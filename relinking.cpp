@@ -0,0 +1,175 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "graph.cpp"
+#include "local_search.cpp"
+#include "archive.cpp"
+
+namespace relinking {
+
+	// path relinking between elite schedules: a path starts from the machine sequences of one elite and every step
+	// moves, on one machine, the operation the other elite has at the first position where their sequences differ to
+	// that position, until the sequences are the other elite's. the machine is the one whose move gives the best
+	// estimate of the local search and doesn't create a cycle, and the graph is updated incrementally. the best schedule
+	// strictly inside a path is improved by a descent. the elites are relinked pair by pair, each from the better one
+	// toward the worse one so that the neighborhood of the better one is the most explored, the pairs are shared by the
+	// workers
+	struct PathRelinking : util::SearchLimits {
+
+		const jssp::Jobs& jobs;
+		int number_of_machines;
+
+		bool local_search = true; // the best schedule of every path is improved by a descent
+		local_search::Neighborhood neighborhood = local_search::Neighborhood::n6;
+		int number_of_threads = 0; // 0 means one per hardware thread
+
+		std::vector<jssp::Schedule> elites;
+		std::vector<int> elite_makespans;
+		std::vector<archive::Sequences> elite_sequences;
+
+		jssp::Schedule best_schedule;
+		int best_makespan = std::numeric_limits<int>::max();
+		std::mutex best_mutex;
+		std::atomic<long> steps = 0;
+
+		PathRelinking(const jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines) {}
+
+		void set_local_search(bool local_search) {
+			this->local_search = local_search;
+		}
+		void set_neighborhood(local_search::Neighborhood neighborhood) {
+			this->neighborhood = neighborhood;
+		}
+		void set_number_of_threads(int number_of_threads) {
+			this->number_of_threads = number_of_threads;
+		}
+
+		// returns false if an elite with the same machine sequences is already there
+		bool add_elite(const jssp::Schedule& schedule) {
+			auto sequences = archive::machine_sequences(jobs, number_of_machines, schedule);
+			if (std::find(elite_sequences.begin(), elite_sequences.end(), sequences) != elite_sequences.end())
+				return false;
+			elites.push_back(schedule);
+			elite_makespans.push_back(jssp::makespan_schedule(elites.back(), jobs.size(), number_of_machines));
+			elite_sequences.push_back(std::move(sequences));
+			return true;
+		}
+
+		void offer(const jssp::Schedule& schedule, int makespan) {
+			{
+				std::lock_guard lock(best_mutex);
+				if (makespan >= best_makespan)
+					return;
+				best_schedule = schedule;
+				best_makespan = makespan;
+			}
+			// outside the lock, the callback may read the best schedule
+			report_improvement(makespan);
+		}
+
+		// walks from the initiating elite to the guiding one with the graph of the search
+		void relink(int initiating, int guiding, local_search::LocalSearch& search) {
+			auto& graph = search.graph;
+			// the guiding sequences as operations, the k-th task of a job on a machine is its operation of index k
+			std::vector<std::vector<int>> guide(number_of_machines);
+			std::vector<int> task_indices(jobs.size(), 0);
+			for (auto& task : elites[guiding]) {
+				int index = task_indices[task.job]++;
+				guide[jobs[task.job][index].machine].push_back(graph.operation(task.job, index));
+			}
+			graph.set_schedule(elites[initiating]);
+
+			// on every machine, the length of the prefix the sequences share and its last operation
+			std::vector<int> matched(number_of_machines, 0);
+			std::vector<int> last_matched(number_of_machines, -1);
+			auto advance = [&](int machine) {
+				while (matched[machine] < guide[machine].size()) {
+					int last = last_matched[machine];
+					int next = last == -1 ? graph.machine_first[machine] : graph.machine_next[last];
+					if (next != guide[machine][matched[machine]])
+						break;
+					last_matched[machine] = next;
+					matched[machine]++;
+				}
+			};
+			for (int machine = 0; machine < number_of_machines; ++machine)
+				advance(machine);
+
+			jssp::Schedule path_best;
+			int path_best_makespan = std::numeric_limits<int>::max();
+			std::vector<local_search::Move> candidates;
+			while (not should_stop()) {
+				candidates.clear();
+				for (int machine = 0; machine < number_of_machines; ++machine) {
+					if (matched[machine] == guide[machine].size())
+						continue;
+					int operation = guide[machine][matched[machine]];
+					int prev = last_matched[machine];
+					candidates.push_back({operation, prev, search.estimate(operation, prev)});
+				}
+				if (candidates.empty())
+					break;
+				std::sort(candidates.begin(), candidates.end(), [](auto& a, auto& b) { return a.estimate < b.estimate; });
+				// when the move of the best estimate creates a cycle, the graph undoes it and the next machine is tried
+				auto moved = std::find_if(candidates.begin(), candidates.end(), [&](auto& move) {
+					return graph.move_after(move.operation, move.prev);
+				});
+				if (moved == candidates.end())
+					break;
+				advance(graph.machines[moved->operation]);
+				count_evaluation();
+				steps.fetch_add(1, std::memory_order_relaxed);
+				bool reached = std::equal(matched.begin(), matched.end(), guide.begin(), [](int length, auto& sequence) {
+					return length == sequence.size();
+				});
+				if (not reached and graph.makespan < path_best_makespan) {
+					path_best_makespan = graph.makespan;
+					path_best = graph.get_schedule();
+				}
+			}
+			if (path_best.empty())
+				return;
+			if (local_search)
+				path_best_makespan = search.run(path_best);
+			offer(path_best, path_best_makespan);
+		}
+
+		// relinks every pair of elites and returns the best schedule found strictly between two of them, best_makespan
+		// holds its makespan. empty when no path had an intermediate schedule
+		jssp::Schedule run() {
+			start_limits();
+			std::vector<int> order(elites.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return elite_makespans[a] < elite_makespans[b]; });
+			std::vector<std::pair<int, int>> pairs;
+			for (int i = 0; i < order.size(); ++i)
+				for (int j = i + 1; j < order.size(); ++j)
+					pairs.push_back({order[i], order[j]});
+
+			std::atomic<int> next_pair = 0;
+			auto work = [&] {
+				local_search::LocalSearch search(jobs, number_of_machines);
+				search.set_neighborhood(neighborhood);
+				for (int i = next_pair++; i < pairs.size() and not should_stop(); i = next_pair++)
+					relink(pairs[i].first, pairs[i].second, search);
+			};
+			int workers = number_of_threads > 0 ? number_of_threads : std::thread::hardware_concurrency();
+			workers = std::clamp<int>(workers, 1, std::max<size_t>(1, pairs.size()));
+			std::vector<std::thread> thread_pool;
+			for (int t = 1; t < workers; ++t)
+				thread_pool.emplace_back(work);
+			work();
+			for (auto& thread : thread_pool)
+				thread.join();
+			return best_schedule;
+		}
+	};
+
+}
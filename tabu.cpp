@@ -0,0 +1,226 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <tuple>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "graph.cpp"
+#include "local_search.cpp"
+
+namespace tabu {
+
+	struct Elite {
+		int makespan;
+		jssp::Schedule schedule;
+	};
+
+	// tabu search on the machine sequences, single threaded: every iteration applies the best estimated move of the
+	// critical block neighborhood that is not tabu, even when it makes the schedule longer. a move reverses the order
+	// of the operation it moves and the ones it jumps over, and putting them back in their old order is tabu for a
+	// random tenure. a tabu move is allowed anyway when its estimate beats the best makespan (aspiration), and when
+	// every move is tabu the best estimated one is applied. the last elite_size best schedules are kept, and after
+	// stagnation_limit iterations without a new best the search restarts from the next of them, perturbed by a few
+	// random moves, with an empty tabu list
+	struct TabuSearch : util::SearchLimits {
+
+		jssp::Jobs& jobs;
+		int number_of_machines;
+
+		local_search::LocalSearch search; // its graph is the current solution, its moves the neighborhood
+		int iterations = std::numeric_limits<int>::max();
+		int min_tenure = 10;
+		int max_tenure = 15;
+		int stagnation_limit = 5000;
+		int elite_size = 8;
+		int perturbation_moves = 5;
+
+		// iteration until which putting job a before job b on the machine is tabu, at [(machine * jobs + a) * jobs + b]
+		std::vector<int> tabu_until;
+		std::vector<int> operation_jobs; // job of every operation of the graph
+		std::vector<std::pair<int, int>> reversed; // (job before, job after) of the pairs the chosen move reverses
+		std::vector<Elite> elites; // best first
+		int next_elite = 0;
+		int lower_bound = 0; // largest job work or machine load, the search stops when it reaches it
+
+		jssp::Schedule best_schedule;
+		int best_makespan = std::numeric_limits<int>::max();
+		long restarts = 0;
+		std::mt19937 random_engine;
+
+		TabuSearch(jssp::Jobs& jobs, int number_of_machines) : jobs(jobs), number_of_machines(number_of_machines),
+			search(jobs, number_of_machines), random_engine(std::random_device()()) {
+			search.set_neighborhood(local_search::Neighborhood::n7);
+			for (int job = 0; job < jobs.size(); ++job)
+				operation_jobs.insert(operation_jobs.end(), jobs[job].size(), job);
+			std::vector<int> machine_loads(number_of_machines, 0);
+			for (auto& job : jobs) {
+				int work = 0;
+				for (auto& task : job) {
+					work += task.time;
+					machine_loads[task.machine] += task.time;
+				}
+				lower_bound = std::max(lower_bound, work);
+			}
+			lower_bound = std::max(lower_bound, *std::max_element(machine_loads.begin(), machine_loads.end()));
+		}
+
+		void set_iterations(int iterations) {
+			this->iterations = iterations;
+		}
+		void set_neighborhood(local_search::Neighborhood neighborhood) {
+			search.set_neighborhood(neighborhood);
+		}
+		void set_tenure(int min_tenure, int max_tenure) {
+			this->min_tenure = std::max(1, min_tenure);
+			this->max_tenure = std::max(this->min_tenure, max_tenure);
+		}
+		void set_stagnation_limit(int stagnation_limit) {
+			this->stagnation_limit = stagnation_limit;
+		}
+		void set_elite_size(int elite_size) {
+			this->elite_size = std::max(1, elite_size);
+		}
+		void set_perturbation_moves(int perturbation_moves) {
+			this->perturbation_moves = perturbation_moves;
+		}
+		void set_seed(unsigned seed) {
+			random_engine.seed(seed);
+		}
+
+		int& tabu(int machine, int job_before, int job_after) {
+			return tabu_until[(machine * jobs.size() + job_before) * jobs.size() + job_after];
+		}
+
+		// calls f with every operation the move jumps over and whether it moves forward, after them
+		void for_each_jumped(const local_search::Move& move, auto&& f) const {
+			auto& graph = search.graph;
+			if (move.prev != -1 and graph.heads[move.prev] > graph.heads[move.operation]) {
+				for (int other = graph.machine_next[move.operation]; other != graph.machine_next[move.prev]; other = graph.machine_next[other])
+					f(other, true);
+			} else {
+				int first = move.prev == -1 ? graph.machine_first[graph.machines[move.operation]] : graph.machine_next[move.prev];
+				for (int other = first; other != move.operation; other = graph.machine_next[other])
+					f(other, false);
+			}
+		}
+
+		// whether the move puts back an order that is still tabu
+		bool is_tabu(const local_search::Move& move, int iteration) {
+			int machine = search.graph.machines[move.operation];
+			int job = operation_jobs[move.operation];
+			bool result = false;
+			for_each_jumped(move, [&](int other, bool forward) {
+				int other_job = operation_jobs[other];
+				result |= (forward ? tabu(machine, other_job, job) : tabu(machine, job, other_job)) > iteration;
+			});
+			return result;
+		}
+		// the pairs of jobs the move reverses, to be made tabu once it is applied. the sequence must not have changed
+		void collect_reversed(const local_search::Move& move) {
+			int job = operation_jobs[move.operation];
+			reversed.clear();
+			for_each_jumped(move, [&](int other, bool forward) {
+				int other_job = operation_jobs[other];
+				reversed.push_back(forward ? std::pair(job, other_job) : std::pair(other_job, job));
+			});
+		}
+		// forbids putting the reversed pairs back in their old order
+		void make_tabu(int machine, int iteration) {
+			int tenure = std::uniform_int_distribution(min_tenure, max_tenure)(random_engine);
+			for (auto [before, after] : reversed)
+				tabu(machine, before, after) = iteration + tenure;
+		}
+
+		void add_elite(int makespan, const jssp::Schedule& schedule) {
+			elites.insert(elites.begin(), {makespan, schedule});
+			if (elites.size() > elite_size)
+				elites.pop_back();
+			next_elite = 0;
+		}
+
+		// the next elite, perturbed by random moves of the neighborhood
+		void restart() {
+			auto& graph = search.graph;
+			graph.set_schedule(elites[next_elite].schedule);
+			next_elite = (next_elite + 1) % elites.size();
+			std::fill(tabu_until.begin(), tabu_until.end(), 0);
+			for (int i = 0; i < perturbation_moves; ++i) {
+				search.generate_moves(graph.critical_path());
+				if (search.moves.empty())
+					break;
+				auto& move = search.moves[std::uniform_int_distribution<size_t>(0, search.moves.size() - 1)(random_engine)];
+				graph.move_after(move.operation, move.prev);
+			}
+			restarts++;
+		}
+
+		// improves the initial schedule, by default the one of the shortest starting time rule, and returns the best
+		// schedule found, best_makespan holds its makespan
+		jssp::Schedule run(const jssp::Schedule& initial_schedule = {}) {
+			start_limits();
+			auto& graph = search.graph;
+			tabu_until.assign(number_of_machines * jobs.size() * jobs.size(), 0);
+			elites.clear();
+			if (initial_schedule.empty())
+				graph.set_schedule(jssp::generate_schedule_shortest_starting_time(jobs, number_of_machines));
+			else
+				graph.set_schedule(initial_schedule);
+			best_makespan = graph.makespan;
+			best_schedule = graph.get_schedule();
+			add_elite(best_makespan, best_schedule);
+			report_improvement(best_makespan);
+
+			int stagnation = 0;
+			std::vector<int> candidates;
+			std::vector<char> allowed;
+			for (int iteration = 0; iteration < iterations and best_makespan > lower_bound and not should_stop(); ++iteration) {
+				count_evaluation();
+				auto path = graph.critical_path();
+				// a path on a single machine can't be shortened
+				if (path.blocks.size() == 1)
+					break;
+				search.generate_moves(path);
+				auto& moves = search.moves;
+				for (auto& move : moves)
+					move.estimate = search.estimate(move.operation, move.prev);
+
+				// allowed moves first, then the tabu ones, each by increasing estimate
+				candidates.clear();
+				for (int i = 0; i < moves.size(); ++i)
+					candidates.push_back(i);
+				allowed.resize(moves.size());
+				for (int i = 0; i < moves.size(); ++i)
+					allowed[i] = moves[i].estimate < best_makespan or not is_tabu(moves[i], iteration);
+				std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+					return std::tuple(not allowed[a], moves[a].estimate) < std::tuple(not allowed[b], moves[b].estimate);
+				});
+				bool moved = false;
+				for (int i : candidates) {
+					auto& move = moves[i];
+					collect_reversed(move);
+					// a move that would create a cycle is undone by the graph
+					if (graph.move_after(move.operation, move.prev)) {
+						make_tabu(graph.machines[move.operation], iteration);
+						moved = true;
+						break;
+					}
+				}
+
+				if (moved and graph.makespan < best_makespan) {
+					best_makespan = graph.makespan;
+					best_schedule = graph.get_schedule();
+					add_elite(best_makespan, best_schedule);
+					report_improvement(best_makespan);
+					stagnation = 0;
+				} else if (not moved or ++stagnation >= stagnation_limit) {
+					restart();
+					stagnation = 0;
+				}
+			}
+			return best_schedule;
+		}
+	};
+
+}
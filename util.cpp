@@ -7,6 +7,8 @@
 #include <iostream>
 #include <fstream>
 #include <semaphore>
+#include <atomic>
+#include <functional>
 
 
 namespace util {
@@ -126,6 +128,66 @@ namespace util {
 			sem.release();  
 		}
 	};
+
+	// flag that another thread can raise to ask a running solver to stop
+	struct CancelToken {
+		std::atomic<bool> cancelled = false;
+
+		void cancel() {
+			cancelled.store(true, std::memory_order_relaxed);
+		}
+		bool is_cancelled() const {
+			return cancelled.load(std::memory_order_relaxed);
+		}
+	};
+
+	// stop criteria shared by the solvers: a wall-clock budget, an evaluation budget and a cancel token
+	struct SearchLimits {
+		// called with the new best makespan, the evaluations done so far and the elapsed time
+		using improvement_callback = std::function<void(int, long, milliseconds)>;
+
+		timer time_limit;
+		bool use_time_limit = false;
+		long max_evaluations = 0; // 0 means no evaluation budget
+		std::atomic<long> evaluations = 0;
+		CancelToken* cancel_token = nullptr;
+		improvement_callback on_improvement = nullptr;
+
+		void set_time_limit(timer::duration_type duration) {
+			time_limit.set_duration(duration);
+			use_time_limit = true;
+		}
+		void set_max_evaluations(long max_evaluations) {
+			this->max_evaluations = max_evaluations;
+		}
+		void set_cancel_token(CancelToken* cancel_token) {
+			this->cancel_token = cancel_token;
+		}
+		void set_on_improvement(improvement_callback on_improvement) {
+			this->on_improvement = std::move(on_improvement);
+		}
+
+		// restart the clock and the evaluation counter, called at the beginning of a run
+		void start_limits() {
+			time_limit.init();
+			evaluations.store(0, std::memory_order_relaxed);
+		}
+		void count_evaluation() {
+			evaluations.fetch_add(1, std::memory_order_relaxed);
+		}
+		// cheap enough to be checked before every evaluation
+		bool should_stop() {
+			if (cancel_token != nullptr and cancel_token->is_cancelled())
+				return true;
+			if (max_evaluations > 0 and evaluations.load(std::memory_order_relaxed) >= max_evaluations)
+				return true;
+			return use_time_limit and time_limit.is_done();
+		}
+		void report_improvement(int makespan) {
+			if (on_improvement)
+				on_improvement(makespan, evaluations.load(std::memory_order_relaxed), time_limit.elapsed<milliseconds>());
+		}
+	};
 	
 }
 
@@ -0,0 +1,260 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <cstdlib>
+#include "util.cpp"
+#include "jssp.cpp"
+#include "graph.cpp"
+#include "local_search.cpp"
+
+namespace vnd {
+
+	// every move of the library reorders a run of consecutive operations of a machine: the run of length operations
+	// that follows prev (-1 for the front) gets the order at [offset, offset + length) of Moves::operations
+	struct Move {
+		int prev;
+		int offset;
+		int length;
+		int estimate;
+	};
+
+	struct Moves {
+		std::vector<int> operations;
+		std::vector<Move> moves;
+
+		void clear() {
+			operations.clear();
+			moves.clear();
+		}
+		void add(int prev, std::initializer_list<int> order) {
+			moves.push_back({prev, int(operations.size()), int(order.size()), 0});
+			operations.insert(operations.end(), order);
+		}
+		// the operations [begin, end) of the path, in the order given by their indices
+		void add(int prev, const std::vector<int>& path, auto&& indices) {
+			moves.push_back({prev, int(operations.size()), 0, 0});
+			for (int i : indices)
+				operations.push_back(path[i]);
+			moves.back().length = operations.size() - moves.back().offset;
+		}
+	};
+
+	// adds the moves of a neighborhood of the critical path to moves
+	using Generator = std::function<void(const graph::DisjunctiveGraph&, const graph::CriticalPath&, Moves&)>;
+
+	// the generators only reorder operations inside the blocks of the critical path, the only moves that can shorten it
+
+	// swap of two adjacent operations of a block (van laarhoven et al.)
+	void swap_moves(const graph::DisjunctiveGraph& graph, const graph::CriticalPath& path, Moves& moves) {
+		auto& operations = path.operations;
+		for (auto [begin, end] : path.blocks)
+			for (int i = begin; i + 1 < end; ++i)
+				moves.add(graph.machine_prev[operations[i]], {operations[i + 1], operations[i]});
+	}
+
+	// an operation of a block moved to its front or its back (balas and vazacopoulos), the moves of one position are swaps
+	void block_shift_moves(const graph::DisjunctiveGraph& graph, const graph::CriticalPath& path, Moves& moves) {
+		auto& operations = path.operations;
+		std::vector<int> indices;
+		for (auto [begin, end] : path.blocks) {
+			int prev = graph.machine_prev[operations[begin]];
+			for (int i = begin + 2; i < end; ++i) {
+				indices.assign({i});
+				for (int k = begin; k < i; ++k)
+					indices.push_back(k);
+				moves.add(prev, operations, indices);
+			}
+			for (int i = begin; i + 2 < end; ++i) {
+				indices.clear();
+				for (int k = i + 1; k < end; ++k)
+					indices.push_back(k);
+				indices.push_back(i);
+				moves.add(i == begin ? prev : operations[i - 1], operations, indices);
+			}
+		}
+	}
+
+	// an operation of a block moved to a position strictly inside it, at least two positions away: the moves to the
+	// ends are block shifts and the others swaps
+	void insert_moves(const graph::DisjunctiveGraph& graph, const graph::CriticalPath& path, Moves& moves) {
+		auto& operations = path.operations;
+		std::vector<int> indices;
+		for (auto [begin, end] : path.blocks) {
+			for (int i = begin; i < end; ++i) {
+				for (int j = begin + 1; j + 1 < end; ++j) {
+					if (std::abs(i - j) < 2)
+						continue;
+					int first = std::min(i, j);
+					int last = std::max(i, j);
+					indices.clear();
+					if (j < i)
+						indices.push_back(i);
+					for (int k = first; k <= last; ++k)
+						if (k != i)
+							indices.push_back(k);
+					if (j > i)
+						indices.push_back(i);
+					moves.add(first == begin ? graph.machine_prev[operations[begin]] : operations[first - 1], operations, indices);
+				}
+			}
+		}
+	}
+
+	// the order of a run of 3 to max_length consecutive operations of a block reversed
+	void reversal_moves(const graph::DisjunctiveGraph& graph, const graph::CriticalPath& path, Moves& moves, int max_length = 4) {
+		auto& operations = path.operations;
+		std::vector<int> indices;
+		for (auto [begin, end] : path.blocks) {
+			for (int length = 3; length <= max_length; ++length) {
+				for (int first = begin; first + length <= end; ++first) {
+					indices.resize(length);
+					std::iota(indices.rbegin(), indices.rend(), first);
+					moves.add(first == begin ? graph.machine_prev[operations[begin]] : operations[first - 1], operations, indices);
+				}
+			}
+		}
+	}
+
+	struct MoveType {
+		std::string name;
+		Generator generate;
+
+		// totals over the descents
+		long estimates = 0;
+		long evaluations = 0; // moves applied to the graph to get their exact makespan
+		long improvements = 0;
+		long gain = 0; // makespan the improvements removed
+		util::nanoseconds time = util::nanoseconds::zero(); // generating, estimating and evaluating
+
+		float success_rate() const {
+			return evaluations == 0 ? 0.f : float(improvements) / evaluations;
+		}
+		// makespan removed per second spent in the neighborhood, infinite until it was searched once
+		double payoff() const {
+			return time == util::nanoseconds::zero() ? std::numeric_limits<double>::infinity() : gain / util::seconds(time).count();
+		}
+	};
+
+	// variable neighborhood descent on the move library: the neighborhoods are searched in turn, and after an
+	// improvement the descent starts again from the first one. a neighborhood's moves are estimated in time
+	// proportional to the operations they reorder, from the heads and tails of the graph, then applied by increasing
+	// estimate with the incremental reordering of the graph until one really shortens the schedule. the others are
+	// undone. the statistics of every move type tell which neighborhoods pay off, and with adaptive order the
+	// neighborhoods are tried by decreasing payoff at the start of every run
+	struct Vnd {
+
+		local_search::LocalSearch search; // its graph holds the schedule, its estimate is the one of the moves
+		std::vector<MoveType> move_types;
+		std::vector<int> order; // of the move types in the current run
+		bool adaptive_order = false;
+		int max_steps = std::numeric_limits<int>::max(); // improving moves applied per run
+		long steps = 0;
+
+		Moves moves;
+		std::vector<int> old_run;
+
+		// the library in increasing order of size: swaps, block shifts, inserts and reversals of 3 or 4 operations
+		Vnd(const jssp::Jobs& jobs, int number_of_machines) : search(jobs, number_of_machines) {
+			add_move_type("swap", swap_moves);
+			add_move_type("block shift", block_shift_moves);
+			add_move_type("insert", insert_moves);
+			add_move_type("reversal", [](auto& graph, auto& path, auto& moves) { reversal_moves(graph, path, moves); });
+		}
+
+		void add_move_type(std::string name, Generator generate) {
+			move_types.push_back({std::move(name), std::move(generate)});
+		}
+		void clear_move_types() {
+			move_types.clear();
+		}
+		void set_adaptive_order(bool adaptive_order) {
+			this->adaptive_order = adaptive_order;
+		}
+		void set_max_steps(int max_steps) {
+			this->max_steps = max_steps;
+		}
+
+		// applies the first move of the neighborhood that shortens the schedule, by increasing estimate
+		bool improve(MoveType& type, const graph::CriticalPath& path) {
+			util::stopwatch sw;
+			auto& graph = search.graph;
+			moves.clear();
+			type.generate(graph, path, moves);
+			for (auto& move : moves.moves) {
+				auto& sequence = search.sequence;
+				sequence.assign(moves.operations.begin() + move.offset, moves.operations.begin() + move.offset + move.length);
+				int last = move.prev == -1 ? graph.machine_first[graph.machines[sequence[0]]] : graph.machine_next[move.prev];
+				for (int k = 1; k < move.length; ++k)
+					last = graph.machine_next[last];
+				move.estimate = search.estimate_sequence(move.prev, graph.machine_next[last]);
+			}
+			type.estimates += moves.moves.size();
+			std::stable_sort(moves.moves.begin(), moves.moves.end(), [](const Move& a, const Move& b) { return a.estimate < b.estimate; });
+
+			bool improved = false;
+			for (auto& move : moves.moves) {
+				if (move.estimate >= graph.makespan)
+					break;
+				int makespan = graph.makespan;
+				type.evaluations++;
+				old_run.clear();
+				for (int operation = move.prev == -1 ? graph.machine_first[graph.machines[moves.operations[move.offset]]] : graph.machine_next[move.prev];
+					old_run.size() < move.length; operation = graph.machine_next[operation])
+					old_run.push_back(operation);
+				if (not graph.reorder(move.prev, moves.operations.data() + move.offset, move.length))
+					continue;
+				if (graph.makespan < makespan) {
+					type.improvements++;
+					type.gain += makespan - graph.makespan;
+					improved = true;
+					break;
+				}
+				// the old order had no cycle, restoring it can't fail
+				graph.reorder(move.prev, old_run.data(), move.length);
+			}
+			type.time += sw.elapsed();
+			return improved;
+		}
+
+		// improves the schedule in place and returns its makespan
+		int run(jssp::Schedule& schedule) {
+			auto& graph = search.graph;
+			graph.set_schedule(schedule);
+			int initial_makespan = graph.makespan;
+			order.resize(move_types.size());
+			std::iota(order.begin(), order.end(), 0);
+			if (adaptive_order)
+				std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return move_types[a].payoff() > move_types[b].payoff(); });
+
+			int step = 0;
+			for (int k = 0; k < order.size() and step < max_steps;) {
+				if (improve(move_types[order[k]], graph.critical_path())) {
+					k = 0;
+					step++;
+				} else {
+					k++;
+				}
+			}
+			steps += step;
+			if (graph.makespan < initial_makespan)
+				schedule = graph.get_schedule();
+			return graph.makespan;
+		}
+
+		void print_statistics() const {
+			util::println("{:<12} {:>12} {:>12} {:>12} {:>10} {:>14} {:>12}", "move", "estimates", "evaluations", "improvements",
+				"success", "evaluations/s", "gain/s");
+			for (auto& type : move_types) {
+				double seconds = util::seconds(type.time).count();
+				util::println("{:<12} {:>12} {:>12} {:>12} {:>9.1f}% {:>14.0f} {:>12.0f}", type.name, type.estimates, type.evaluations,
+					type.improvements, 100 * type.success_rate(), seconds == 0 ? 0. : type.evaluations / seconds, seconds == 0 ? 0. : type.gain / seconds);
+			}
+		}
+	};
+
+}